@@ -0,0 +1,54 @@
+/*
+ ============================================================================
+ Name        : GPIO_Bench.h
+ Author      : Farah Mohey
+ Description : Header file for GPIO_Bench ( To compare the cycles of the per-pin & port-wide GPIO APIs)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef APP_GPIO_BENCH_H_
+#define APP_GPIO_BENCH_H_
+
+/******************************* Includes *************************************/
+#include "LIB/Std_Types.h"
+#include "LIB/Errors_enum.h"
+
+/***************************** Definitions *************************************/
+
+/* Number of times every measurement is repeated , the minimum is kept to drop the stalls of the bus & flash */
+#define GPIO_BENCH_REPEATS		16
+
+/***************************** Types Declaration *******************************/
+
+/*Result of the benchmark in processor clock cycles (The cost of reading CYCCNT is already removed ,
+ * the cost of the loop over the pins is removed from the per-pin API cycles & reported in PinLoopCycles) */
+typedef struct
+{
+	u32 PinsNumber;				/* Number of pins in the mask of the benchmark */
+	u32 PinLoopCycles;			/* Empty loop over the 16 pins testing the mask (Baseline of the per-pin API) */
+	u32 PinApiWriteCycles;		/* GPIO_Set_PinValue called for every pin */
+	u32 PortApiWriteCycles;		/* One GPIO_Set_PortMask for all the pins */
+	u32 PinApiReadCycles;		/* GPIO_Get_PinValue called for every pin */
+	u32 PortApiReadCycles;		/* One GPIO_Get_PortValue for all the pins */
+	u32 PinApiWriteCyclesPerPin;
+	u32 PortApiWriteCyclesPerPin;
+	u32 PinApiReadCyclesPerPin;
+	u32 PortApiReadCyclesPerPin;
+}GPIO_Bench_Result_t;
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief    : Measures the cycles of updating & reading a group of pins with the per-pin & port-wide APIs.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: PinsMask - Pins of the benchmark , bit n for pin n (Already initialized as outputs).
+ * @param[out]: Result - Pointer to store the cycles of every API in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Uses the DWT cycle counter with the interrupts disabled (Started if needed , never cleared) , the pins
+ *             are toggled during the benchmark & left reset at its end. Read the result from the debugger (Or trace_printf).
+ */
+enumError_t GPIO_Bench_Run(void *Port , u32 PinsMask , GPIO_Bench_Result_t *Result);
+
+
+#endif /* APP_GPIO_BENCH_H_ */
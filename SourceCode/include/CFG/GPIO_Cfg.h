@@ -0,0 +1,25 @@
+/*
+ ============================================================================
+ Name        : GPIO_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file for configuring GPIO (General-purpose I/Os for STM32F401xC)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_GPIO_CFG_H_
+#define CFG_GPIO_CFG_H_
+
+/*******************************  Definitions  *********************************/
+
+/* Options can be --> GPIO_ENABLE , GPIO_DISABLE */
+
+/* Checks of the inline fast path (GPIO_WriteFast , GPIO_ReadFast , ...) : Enable it in the debug builds to validate
+ * the port & the pin at runtime & stop in GPIO_FastCheckFailed on a wrong one , disabled the fast path is only the
+ * access of the register */
+#define GPIO_FAST_CHECK					GPIO_DISABLE
+
+
+
+#endif /* CFG_GPIO_CFG_H_ */
@@ -0,0 +1,60 @@
+/*
+ ============================================================================
+ Name        : GPIO_Image_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file of the register images of the GPIO ports
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef CFG_GPIO_IMAGE_CFG_H_
+#define CFG_GPIO_IMAGE_CFG_H_
+
+/* Generated by tools/GPIO_Image.py from LEDS[] & SWITCHES[] , don't edit it manually */
+
+/*******************************  Definitions  *********************************/
+
+/* Number of ports in GPIO_IMAGE_TABLE */
+#define GPIO_IMAGE_PORTS			2
+
+/* Number of LEDs & switches the images are generated from (Checked against LED_Cfg.h & SWITCH_Cfg.h) */
+#define GPIO_IMAGE_LEDS				3
+#define GPIO_IMAGE_SWITCHES			3
+
+/* Images of the ports : Port , MODER , OTYPER , OSPEEDR , PUPDR , AFRL , AFRH , BSRR */
+#define GPIO_IMAGE_PORT0				GPIO_PORTA
+#define GPIO_IMAGE_PORT0_MODER			0xA8000015
+#define GPIO_IMAGE_PORT0_OTYPER			0x00000000
+#define GPIO_IMAGE_PORT0_OSPEEDR		0x0C00002A
+#define GPIO_IMAGE_PORT0_PUPDR			0x64000000
+#define GPIO_IMAGE_PORT0_AFRL			0x00000000
+#define GPIO_IMAGE_PORT0_AFRH			0x00000000
+#define GPIO_IMAGE_PORT0_BSRR			0x00000007
+
+#define GPIO_IMAGE_PORT1				GPIO_PORTB
+#define GPIO_IMAGE_PORT1_MODER			0x00000080
+#define GPIO_IMAGE_PORT1_OTYPER			0x00000000
+#define GPIO_IMAGE_PORT1_OSPEEDR		0x000000C0
+#define GPIO_IMAGE_PORT1_PUPDR			0x00001500
+#define GPIO_IMAGE_PORT1_AFRL			0x00000000
+#define GPIO_IMAGE_PORT1_AFRH			0x00000000
+#define GPIO_IMAGE_PORT1_BSRR			0x00000000
+
+/* Initializer of the GPIO_Image_t of the ports (GPIO_IMAGE_ROW of src/CFG/GPIO_Image_Cfg.c) */
+#define GPIO_IMAGE_TABLE \
+	GPIO_IMAGE_ROW(0) , \
+	GPIO_IMAGE_ROW(1)
+
+/* Pins the images are generated from : Entry(Arg , Index of the port in GPIO_IMAGE_TABLE , Pin , Mood , Speed , AltFunc , Level)
+ * Level is the initial level of a LED (0 for the switches) , checked against the images in src/CFG/GPIO_Image_Cfg.c */
+#define GPIO_IMAGE_PINS(Entry , Arg) \
+	Entry(Arg , 0 , GPIO_PIN0 , GPIO_OUTPUT_PP , GPIO_HIGH_SPEED , GPIO_AF0 , 1)	/*LEDS[LED1]*/ \
+	Entry(Arg , 0 , GPIO_PIN1 , GPIO_OUTPUT_PP , GPIO_HIGH_SPEED , GPIO_AF0 , 1)	/*LEDS[LED2]*/ \
+	Entry(Arg , 0 , GPIO_PIN2 , GPIO_OUTPUT_PP , GPIO_HIGH_SPEED , GPIO_AF0 , 1)	/*LEDS[LED3]*/ \
+	Entry(Arg , 1 , GPIO_PIN4 , GPIO_INPUT_PU , GPIO_LOW_SPEED , GPIO_AF0 , 0)	/*SWITCHES[Switch1]*/ \
+	Entry(Arg , 1 , GPIO_PIN5 , GPIO_INPUT_PU , GPIO_LOW_SPEED , GPIO_AF0 , 0)	/*SWITCHES[Switch2]*/ \
+	Entry(Arg , 1 , GPIO_PIN6 , GPIO_INPUT_PU , GPIO_LOW_SPEED , GPIO_AF0 , 0)	/*SWITCHES[Switch3]*/
+
+
+
+#endif /* CFG_GPIO_IMAGE_CFG_H_ */
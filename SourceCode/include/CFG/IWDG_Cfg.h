@@ -0,0 +1,23 @@
+/*
+ ============================================================================
+ Name        : IWDG_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file for configuring IWDG (Independent watchdog for STM32F401xC)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_IWDG_CFG_H_
+#define CFG_IWDG_CFG_H_
+
+/*******************************  Definitions  *********************************/
+
+
+ /*Frequency of the LSI clocking the watchdog (17 to 47 KHz , typical 32 KHz) */
+
+#define IWDG_LSI_FREQUENCY_HZ			32000
+
+
+
+#endif /* CFG_IWDG_CFG_H_ */
@@ -0,0 +1,27 @@
+/*
+ ============================================================================
+ Name        : RCC_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file for configuring RCC (Reset and clock control for STM32F401xC)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_RCC_CFG_H_
+#define CFG_RCC_CFG_H_
+
+/*******************************  Definitions  *********************************/
+
+
+ /*Frequency of the external crystal / oscillator of the board (4 to 26 MHz) */
+
+#define RCC_HSE_FREQUENCY_HZ			25000000
+
+ /*Number of callbacks notified when HCLK changes (STK , Scheduler , ...) */
+
+#define RCC_MAX_CLOCK_CALLBACKS			4
+
+
+
+#endif /* CFG_RCC_CFG_H_ */
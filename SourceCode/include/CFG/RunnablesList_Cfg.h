@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ Name        : RunnablesList_Cfg.h
+ Author      : Farah Mohey
+ Description : Header File for Configuring the Scheduler Runnables List
+ Created	 : 12-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_RUNNABLESLIST_CFG_H_
+#define CFG_RUNNABLESLIST_CFG_H_
+
+
+/**************************		Types Declaration	 ******************************/
+/* Configure The Runnables Name in this Enum , it is used as index in RunnableList */
+typedef enum
+{
+	/*Ex :
+	SWITCH,
+	app1,
+	app2,
+	Traffic,
+	LCD,
+	*/
+
+	/*Indicate number of runnables, don't use it */
+	_MaxRunnables
+}RunnablesList_t;
+
+/* Configure The Operating Modes in this Enum (SCHED_MODES) , it is used as index in SchedModeList
+ * The first mode is the one started by Sched_Init */
+typedef enum
+{
+	/*Ex :
+	MODE_STARTUP,
+	MODE_NORMAL,
+	MODE_DEGRADED,
+	MODE_LOW_POWER,
+	*/
+
+	/*Indicate number of modes, don't use it */
+	_MaxSchedModes
+}SchedModesList_t;
+
+
+
+#endif /* CFG_RUNNABLESLIST_CFG_H_ */
@@ -14,10 +14,20 @@
 /*******************************  Definitions  *********************************/
 
 
- /*Configure with clock frequency */
+ /*Expected HCLK in Hz for the build time checks (Scheduler tick , tools/Sched_Tick.py) & the simulator ,
+  *the driver reads the real HCLK from RCC at runtime */
 
 #define CLK_FREQUENCY_MHZ				16000000
 
+ /*Highest HCLK in Hz the application switches to by RCC (84 MHz at most on the STM32F401) , the periods
+  *loaded in the SysTick (Scheduler tick , tools/Sched_Tick.py) must fit in its 24 bit RELOAD at this clock */
+
+#define CLK_MAX_FREQUENCY_HZ			84000000
+
+ /*Number of callbacks added by STK_AddCallBack to the one of STK_SetCallBack (e.g. Service/SwTimer.c) */
+
+#define STK_MAX_ADDED_CALLBACKS			2
+
 
 
 #endif /* CFG_STK_CFG_H_ */
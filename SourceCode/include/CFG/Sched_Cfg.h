@@ -0,0 +1,98 @@
+/*
+ ============================================================================
+ Name        : Sched_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file for configuring the Scheduler
+ Created	 : 20-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_SCHED_CFG_H_
+#define CFG_SCHED_CFG_H_
+
+/*******************************  Definitions  *********************************/
+
+/* Number of slots of the pool of the runnables added at runtime by Sched_AddRunnable
+ * (RunnableList + pool must be less than 255) */
+#define SCHED_DYNAMIC_RUNNABLES			8
+
+/* Options can be --> SCHED_ENABLE , SCHED_DISABLE */
+
+/* Tick profiling : Every Sched() call is timestamped with the DWT cycle counter & the count , max & average
+ * cycles of the ticks are kept to be read by Sched_GetTickStats (Benchmark of the tick cost against _MaxRunnables) */
+#define SCHED_TICK_PROFILING			SCHED_DISABLE
+
+/* Tickless idle mode : When no tick is pending the SysTick is reprogrammed to expire at the
+ * nearest release of the runnables & the CPU sleeps (WFI) instead of waking up every tick */
+#define SCHED_TICKLESS_MODE				SCHED_DISABLE
+
+/* Software timers : The tickless sleeps end at the tick before the nearest expiry of Service/SwTimer.h , so the
+ * SysTick handler of the next tick expires the timers on time (Needs SwTimer_Init & src/Service/SwTimer.c) */
+#define SCHED_SW_TIMERS					SCHED_DISABLE
+
+/* Execution time profiling : Every runnable callback is timestamped with the DWT cycle counter
+ * & its min , max , average cycles are kept to be read by Sched_GetRunnableStats */
+#define SCHED_PROFILING					SCHED_DISABLE
+
+/* Release jitter : The start of every periodic runnable is timestamped with the DWT cycle counter against the start
+ * of its release tick (Taken from the SysTick VAL at the tick) & the latency is counted in a histogram of
+ * SCHED_JITTER_BUCKETS buckets of SCHED_JITTER_BUCKET_US each (The last one counts the longer latencies)
+ * read by Sched_GetJitterHistogram */
+#define SCHED_JITTER					SCHED_DISABLE
+#define SCHED_JITTER_BUCKETS			16
+#define SCHED_JITTER_BUCKET_US			50
+
+/* CPU load monitor : The idle branch of Sched_Start is timestamped with the DWT cycle counter & the load is published
+ * at the end of every window of SCHED_LOAD_WINDOWS_MS (Average over the last completed window , in per mille)
+ * with the peak of the shortest window , read by Sched_GetCpuLoad & Sched_GetPeakCpuLoad
+ * Every window must be shorter than 2 pwr 32 processor cycles (268 s at 16 MHz) */
+#define SCHED_LOAD_MONITOR				SCHED_DISABLE
+#define SCHED_LOAD_WINDOWS_MS			{ 100 , 1000 , 10000 }
+
+/* Schedulability check : Sched_Init returns Sched_NotSchedulable when the declared WCET (WcetUs) of the periodic runnables
+ * give a utilization or a worst tick load (Releases of the tick + work left by the previous ticks , over the hyperperiod)
+ * above SCHED_LOAD_LIMIT_PERMILLE (The rest is left for the scheduler & the interrupts)
+ * Only the first SCHED_CHECK_MAX_TICKS ticks of a longer hyperperiod are checked
+ * Calibration : The check takes the longest measured execution (Needs SCHED_PROFILING) when it is longer than WcetUs ,
+ * Sched_CheckSchedulability is called again after running the worst cases */
+#define SCHED_SCHEDULABILITY_CHECK		SCHED_DISABLE
+#define SCHED_CALIBRATION				SCHED_DISABLE
+#define SCHED_LOAD_LIMIT_PERMILLE		900
+#define SCHED_CHECK_MAX_TICKS			10000
+
+/* Execution budget : The SysTick checks the running runnable of each level against its BudgetUs with the resolution
+ * of one tick (A background runnable doesn't consume its budget while preempted by the high priority level)
+ * An overrun is counted (Sched_GetBudgetOverruns) & passed from the SysTick to the handler set by Sched_SetBudgetHandler
+ * which chooses the action : SCHED_BUDGET_CONTINUE , SCHED_BUDGET_SUSPEND or SCHED_BUDGET_RESET */
+#define SCHED_BUDGET_ENFORCEMENT		SCHED_DISABLE
+
+/* Watchdog : The IWDG is started by Sched_Start & refreshed by every pass of the background loop , so a runnable which
+ * never returns resets the microcontroller after SCHED_WATCHDOG_TIMEOUT_MS (Longer than the longest budget & pass)
+ * The tickless sleeps are limited to half of the timeout */
+#define SCHED_WATCHDOG					SCHED_DISABLE
+#define SCHED_WATCHDOG_TIMEOUT_MS		100
+
+/* Preemptive mode : Runnables with SCHED_PRIORITY_HIGH are executed from PendSV preempting the background loop
+ * SysTick must have a higher preemption priority (Lower value) than PendSV to keep counting the ticks meanwhile
+ * Sched_Init sets SCHED_PRIORITY_GROUP (MCAL/NVIC.h) once as the grouping of the application & fails if a priority is wrong */
+#define SCHED_PREEMPTIVE_MODE			SCHED_DISABLE
+#define SCHED_PRIORITY_GROUP			PRIORITY_GROUP0
+#define SCHED_SYSTICK_PREEMPT_PRIO		14
+#define SCHED_PENDSV_PREEMPT_PRIO		15
+
+/* Operating modes : Every mode of SchedModesList_t (CFG/RunnablesList_Cfg.h) has a table of the static runnables
+ * in SchedModeList , a runnable without callback in the table of a mode is inactive in it (Not in the timing wheels)
+ * Sched_Init starts in the first mode , Sched_SetMode switches all the tables at once at the next tick boundary
+ * A runnable active in both modes keeps its next release (Phase) & takes the period of the new table
+ * Not available with SCHED_OPTIMIZED_OFFSETS (Generated from RunnableList only) */
+#define SCHED_MODES						SCHED_DISABLE
+
+/* Optimized offsets : The first release of the runnables is taken from RunnableOffsetsUs generated by
+ * tools/Sched_Offsets.py (src/CFG/RunnablesOffsets_Cfg.c) instead of DelayTimeMs + DelayTimeUs
+ * to spread the releases over the ticks of the hyperperiod (Without SCHED_MODES) */
+#define SCHED_OPTIMIZED_OFFSETS			SCHED_DISABLE
+
+
+
+#endif /* CFG_SCHED_CFG_H_ */
@@ -0,0 +1,23 @@
+/*
+ ============================================================================
+ Name        : SwTimer_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file for configuring the software timers
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_SWTIMER_CFG_H_
+#define CFG_SWTIMER_CFG_H_
+
+/*******************************  Definitions  *********************************/
+
+
+ /*Number of software timers of the static pool (Less than 65535) */
+
+#define SWTIMER_MAX_TIMERS				64
+
+
+
+#endif /* CFG_SWTIMER_CFG_H_ */
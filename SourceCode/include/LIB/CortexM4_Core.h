@@ -0,0 +1,166 @@
+/*
+ ============================================================================
+ Name        : CortexM4_Core.h
+ Author      : Farah Mohey
+ Description : Header file for Cortex-M4 core instructions used by the drivers
+ Created	 : 20-Apr-24
+ ============================================================================
+ */
+
+#ifndef LIB_CORTEXM4_CORE_H_
+#define LIB_CORTEXM4_CORE_H_
+
+/******************************* Includes *************************************/
+#include "LIB/Std_Types.h"
+
+#if defined(CORE_SIM)
+/* Host build : The core instructions & the exceptions are emulated by src/SIM/Core_Sim.c */
+#include "SIM/Core_Sim.h"
+#else
+
+/************************** Functions Implementation **************************/
+
+/*
+ * @brief   : Counts the leading zero bits of a word (CLZ).
+ * @param   : Value - Word to be scanned.
+ * @return  : u32 - Position of the most significant set bit counted from bit 31 (32 --> Value is zero).
+ */
+static inline u32 Core_CountLeadingZeros(u32 Value)
+{
+	u32 loc_Zeros;
+
+	__asm volatile ("clz %0, %1" : "=r" (loc_Zeros) : "r" (Value));
+
+	return loc_Zeros;
+}
+
+/*
+ * @brief   : Disables all the configurable interrupts (Sets PRIMASK).
+ * @details : A pending interrupt still wakes the core up from WFI while PRIMASK is set,
+ * 				but its handler is not executed till Core_EnableIRQ is called.
+ */
+static inline void Core_DisableIRQ(void)
+{
+	__asm volatile ("cpsid i" : : : "memory");
+}
+
+/*
+ * @brief   : Enables all the configurable interrupts (Clears PRIMASK).
+ */
+static inline void Core_EnableIRQ(void)
+{
+	__asm volatile ("cpsie i" : : : "memory");
+}
+
+/*
+ * @brief   : Disables all the configurable interrupts & returns their previous state (Saves PRIMASK then sets it).
+ * @return  : u32 - PRIMASK before the call , given back to Core_RestoreIRQ.
+ * @details : Nests safely , used by code that may be called with the interrupts already disabled.
+ */
+static inline u32 Core_SaveDisableIRQ(void)
+{
+	u32 loc_Primask;
+
+	__asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (loc_Primask) : : "memory");
+
+	return loc_Primask;
+}
+
+/*
+ * @brief   : Restores the state of the interrupts saved by Core_SaveDisableIRQ (Writes PRIMASK).
+ * @param   : Primask - Value returned by Core_SaveDisableIRQ.
+ */
+static inline void Core_RestoreIRQ(u32 Primask)
+{
+	__asm volatile ("msr primask, %0" : : "r" (Primask) : "memory");
+}
+
+/*
+ * @brief   : Puts the core in sleep mode till an interrupt is pending (Wait For Interrupt).
+ */
+static inline void Core_WaitForInterrupt(void)
+{
+	__asm volatile ("wfi" : : : "memory");
+}
+
+/*
+ * @brief   : Spends one pass of an idle loop waiting for an interrupt without sleeping.
+ * @details : The host simulator advances its virtual clock to the next interrupt instead.
+ */
+static inline void Core_Idle(void)
+{
+	__asm volatile ("nop" : : : "memory");
+}
+
+/*
+ * @brief   : Orders the memory accesses before it ahead of the ones after it (Data Memory Barrier).
+ * @details : Publishes data before the index telling another context (ISR , DMA) it is ready.
+ */
+static inline void Core_DataMemoryBarrier(void)
+{
+	__asm volatile ("dmb 0xF" : : : "memory");
+}
+
+/*
+ * @brief   : Waits till all the previous memory accesses are completed (Data Synchronization Barrier).
+ */
+static inline void Core_DataSyncBarrier(void)
+{
+	__asm volatile ("dsb 0xF" : : : "memory");
+}
+
+/*
+ * @brief   : Gets the number of the exception being handled (IPSR).
+ * @return  : u32 - 0 --> Thread mode , Otherwise the exception number (e.g. 14 --> PendSV , 15 --> SysTick).
+ */
+static inline u32 Core_GetActiveException(void)
+{
+	u32 loc_Ipsr;
+
+	__asm volatile ("mrs %0, ipsr" : "=r" (loc_Ipsr));
+
+	return loc_Ipsr;
+}
+
+/*
+ * @brief   : Sets bits of a word shared with interrupts without disabling them (LDREX / STREX).
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be set.
+ * @details : The store fails & is retried if an interrupt accessed the word in between.
+ */
+static inline void Core_AtomicSetBits(volatile u32 *Word , u32 Mask)
+{
+	u32 loc_Value;
+	u32 loc_Failed;
+
+	do
+	{
+		__asm volatile ("ldrex %0, [%1]" : "=r" (loc_Value) : "r" (Word) : "memory");
+		loc_Value |= Mask;
+		__asm volatile ("strex %0, %2, [%1]" : "=&r" (loc_Failed) : "r" (Word) , "r" (loc_Value) : "memory");
+	} while (loc_Failed);
+}
+
+/*
+ * @brief   : Clears bits of a word shared with interrupts without disabling them (LDREX / STREX).
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be cleared.
+ * @details : The store fails & is retried if an interrupt accessed the word in between.
+ */
+static inline void Core_AtomicClearBits(volatile u32 *Word , u32 Mask)
+{
+	u32 loc_Value;
+	u32 loc_Failed;
+
+	do
+	{
+		__asm volatile ("ldrex %0, [%1]" : "=r" (loc_Value) : "r" (Word) : "memory");
+		loc_Value &= ~Mask;
+		__asm volatile ("strex %0, %2, [%1]" : "=&r" (loc_Failed) : "r" (Word) , "r" (loc_Value) : "memory");
+	} while (loc_Failed);
+}
+
+#endif /* CORE_SIM */
+
+
+#endif /* LIB_CORTEXM4_CORE_H_ */
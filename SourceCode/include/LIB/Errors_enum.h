@@ -26,6 +26,13 @@ typedef enum
 	RCC_ClkReady,		/* RCC Clock is Ready */
 	RCC_ClkNotReady,	/* RCC Clock is Not Ready */
 
+	Sched_NotSchedulable,	/* The runnables don't fit in the CPU (Utilization or worst tick load above the limit) */
+
+	RingBuffer_Full,		/* No free element in the ring buffer */
+	RingBuffer_Empty,		/* No element to be popped from the ring buffer */
+
+	STK_PeriodOutOfRange,	/* The period set in time units doesn't fit in the SysTick at the current HCLK */
+
 }enumError_t;
 
 
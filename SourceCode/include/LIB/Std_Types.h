@@ -18,9 +18,23 @@ typedef signed char			s8;
 typedef unsigned short int	u16;
 typedef signed short int	s16;
 
+#ifdef CORE_SIM
+/* Host build of the simulators : long is 64 bits on the host , the fixed width types keep u32 & s32
+ * at 32 bits so the counters wrap around at the same value as on the target */
+#include <stdint.h>
+
+typedef uint32_t			u32;
+typedef int32_t				s32;
+
+/* Integer holding an address , to check its alignment */
+typedef uintptr_t			uptr;
+#else
 typedef unsigned long  int	u32;
 typedef signed long  int	s32;
 
+typedef unsigned long  int	uptr;
+#endif
+
 
 typedef unsigned long long    u64;
 typedef signed long long      s64;
@@ -0,0 +1,46 @@
+/*
+ ============================================================================
+ Name        : DWT.h
+ Author      : Farah Mohey
+ Description : Header file for DWT (Data watchpoint and trace unit of Cortex-M4) cycle counter
+ Created	 : 22-Apr-24
+ ============================================================================
+ */
+
+#ifndef MCAL_DWT_H_
+#define MCAL_DWT_H_
+
+/******************************* Includes *************************************/
+#include "LIB/Std_Types.h"
+#include "LIB/Masks.h"
+#include "LIB/Errors_enum.h"
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Enables the cycle counter of the DWT.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Enables the trace unit (TRCENA) , clears CYCCNT & starts counting the processor clock cycles.
+ */
+enumError_t DWT_Init(void);
+
+/*
+ * @brief   : Starts the cycle counter of the DWT if it isn't already counting.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Never clears CYCCNT , so the timestamps taken by the other users of the counter (Scheduler profiling ,
+ * 				the debugger) stay valid.
+ */
+enumError_t DWT_Start(void);
+
+/*
+ * @brief   : Gets the current value of the cycle counter (CYCCNT).
+ * @param   : None
+ * @return  : u32 - Processor clock cycles counted since DWT_Init , wraps around every 2 pwr 32 cycles.
+ * @details : Returns the value directly without validation to keep it usable to timestamp hot paths.
+ */
+u32 DWT_GetCycleCount(void);
+
+
+#endif /* MCAL_DWT_H_ */
@@ -14,14 +14,34 @@
 #include  	"LIB/Std_Types.h"
 #include  	"LIB/Masks.h"
 #include  	"LIB/Errors_enum.h"
+#include  	"CFG/GPIO_Cfg.h"
 
 /******************************* Definitions ***********************************/
+#if defined(CORE_SIM)
+/*Host build : The ports are at the same offsets in the fake registers of the test (src/SIM/GPIO_Sim.c) */
+#define GPIO_SIM_REGISTERS_SIZE		0x2000
+extern u8 GPIO_Sim_Registers[GPIO_SIM_REGISTERS_SIZE];
+
+#define GPIO_PORTA  (void *)(&GPIO_Sim_Registers[0x0000])
+#define GPIO_PORTB	(void *)(&GPIO_Sim_Registers[0x0400])
+#define GPIO_PORTC  (void *)(&GPIO_Sim_Registers[0x0800])
+#define GPIO_PORTD 	(void *)(&GPIO_Sim_Registers[0x0C00])
+#define GPIO_PORTE 	(void *)(&GPIO_Sim_Registers[0x1000])
+#define GPIO_PORTH	(void *)(&GPIO_Sim_Registers[0x1C00])
+#else
 #define GPIO_PORTA  (void *)(0x40020000)
 #define GPIO_PORTB	(void *)(0x40020400)
 #define GPIO_PORTC  (void *)(0x40020800)
 #define GPIO_PORTD 	(void *)(0x40020C00)
 #define GPIO_PORTE 	(void *)(0x40021000)
 #define GPIO_PORTH	(void *)(0x40021C00)
+#endif /* CORE_SIM */
+
+#define GPIO_IS_VALID_PORT(Port)	( ( (Port) >= GPIO_PORTA && (Port) <= GPIO_PORTE ) || (Port) == GPIO_PORTH )
+
+/*Options of CFG/GPIO_Cfg.h*/
+#define GPIO_ENABLE		1
+#define GPIO_DISABLE	0
 
 /********************Macros for the GPIO pins********************/
 #define GPIO_PIN0 	0x00000000
@@ -69,9 +89,38 @@
 #define GPIO_AF_OD_PU		0x0000000E
 #define GPIO_AF_OD_PD		0x00000016
 
+/********************Macros for the GPIO alternate functions********************/
+/*Peripheral of a pin in the GPIO_AF_* moods , the mapping of every pin is in the datasheet (Alternate function mapping)*/
+#define GPIO_AF0			0x00000000	/*SYS (MCO , SWD , ...)*/
+#define GPIO_AF1			0x00000001	/*TIM1 , TIM2*/
+#define GPIO_AF2			0x00000002	/*TIM3 , TIM4 , TIM5*/
+#define GPIO_AF3			0x00000003	/*TIM9 , TIM10 , TIM11*/
+#define GPIO_AF4			0x00000004	/*I2C1 , I2C2 , I2C3*/
+#define GPIO_AF5			0x00000005	/*SPI1 , SPI2 , SPI3 , SPI4*/
+#define GPIO_AF6			0x00000006	/*SPI2 , SPI3 , SPI4*/
+#define GPIO_AF7			0x00000007	/*SPI3 , USART1 , USART2*/
+#define GPIO_AF8			0x00000008	/*USART6*/
+#define GPIO_AF9			0x00000009	/*I2C2 , I2C3*/
+#define GPIO_AF10			0x0000000A	/*OTG_FS*/
+#define GPIO_AF11			0x0000000B
+#define GPIO_AF12			0x0000000C	/*SDIO*/
+#define GPIO_AF13			0x0000000D
+#define GPIO_AF14			0x0000000E
+#define GPIO_AF15			0x0000000F	/*EVENTOUT*/
+
 #define GPIO_SET_PIN 		BIT0_MASK	/*first 16 pin set*/
 #define GPIO_RESET_PIN 		BIT16_MASK	/*last 16 pin reset*/
 
+/********************Masks for the whole port********************/
+#define GPIO_PIN_MASK(PinNum)	(1UL << (PinNum))	/*Bit of a pin in the masks of the port (GPIO_PIN0 --> GPIO_PIN15)*/
+#define GPIO_ALL_PINS_MASK		0x0000FFFF			/*The 16 pins of the port*/
+
+/********************Registers of the inline fast path********************/
+#define GPIO_IDR_INDEX			4		/*Offset 0x10*/
+#define GPIO_BSRR_INDEX			6		/*Offset 0x18*/
+#define GPIO_BSRR_RESET_SHIFT	16		/*Reset bits of BSRR*/
+#define GPIO_REG(Port , Index)	( ((volatile u32 *)(Port))[Index] )
+
 /************************* Types Declaration ********************************/
 
 /*Struct for new GPIO pin configuration */
@@ -82,9 +131,26 @@ typedef struct
 	u32  Pin;
 	u32  Speed;
 	u32  Mood;
+	u32  AltFunc;	/*GPIO_AF0 --> GPIO_AF15 for the GPIO_AF_* moods , the other moods reset the pin to GPIO_AF0*/
 
 }GPIO_Config_t;
 
+/*Final register values of a port generated at build time by tools/GPIO_Image.py (CFG/GPIO_Image_Cfg.h) */
+typedef struct
+{
+	void* Port;
+	u32  MODER;
+	u32  OTYPER;
+	u32  OSPEEDR;
+	u32  PUPDR;
+	u32  AFRL;
+	u32  AFRH;
+	u32  BSRR;		/*Initial levels of the outputs*/
+}GPIO_Image_t;
+
+/*Images of the ports of LEDS[] & SWITCHES[] (src/CFG/GPIO_Image_Cfg.c) , GPIO_IMAGE_PORTS of CFG/GPIO_Image_Cfg.h */
+extern const GPIO_Image_t GPIO_Images[];
+
 /************************** Functions Prototypes ******************************/
 
 /*
@@ -95,6 +161,30 @@ typedef struct
  */
 enumError_t GPIO_InitPin (GPIO_Config_t *Loc_GPIOElement);
 
+/*
+ * @brief    : Initializes a group of GPIO pins writing every register of a port once.
+ * @param[in]: Configs - Array of the configurations of the pins (Any order , any ports).
+ * @param[in]: Count - Number of configurations in the array.
+ * @return   : enumError_t - Error status indicating success or failure of the initialization.
+ * @details  : All the configurations are validated before writing any register , so on an error no pin is changed.
+ *             The fields of the pins are gathered per port in local variables then MODER , OTYPER , OSPEEDR ,
+ *             PUPDR , AFRL & AFRH of every used port are read-modified-written once instead of once per pin.
+ *             A pin repeated in the array takes its last configuration like successive GPIO_InitPin.
+ */
+enumError_t GPIO_InitPins (const GPIO_Config_t *Configs , u32 Count);
+
+/*
+ * @brief    : Initializes whole ports from their register images precomputed at build time.
+ * @param[in]: Images - Array of the images of the ports (e.g. GPIO_Images).
+ * @param[in]: Count - Number of images in the array (e.g. GPIO_IMAGE_PORTS).
+ * @return   : enumError_t - Error status indicating success or failure of the initialization.
+ * @details  : Every register of a port is stored once without reading it , the pins out of the tables of the
+ *             generator take their reset configuration , so it is called at boot before any other GPIO setting.
+ *             The output levels are stored first & MODER last so the outputs start driving their initial level.
+ *             All the ports are validated before writing any register.
+ */
+enumError_t GPIO_InitImages (const GPIO_Image_t *Images , u32 Count);
+
 /*
  * @brief    : Sets the value of a GPIO pin to a specified state.
  * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
@@ -115,6 +205,124 @@ enumError_t GPIO_Set_PinValue(void *Port , u32 PinNum , u32 PinState );
  */
 enumError_t GPIO_Get_PinValue(void *Port , u32 PinNum,  u32 *PinStatus) ;
 
+/*
+ * @brief    : Sets & resets any group of pins of a port together.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: SetMask - Pins to be set , bit n for pin n (GPIO_PIN_MASK(GPIO_PINx) | ... , up to GPIO_ALL_PINS_MASK).
+ * @param[in]: ResetMask - Pins to be reset , bit n for pin n (up to GPIO_ALL_PINS_MASK).
+ * @return   : enumError_t - Error status indicating success or failure of setting the pins values.
+ * @details  : All the pins change with one write of BSRR , at the same clock & without read-modify-write
+ *             so it is safe against the interrupts changing other pins of the port.
+ *             The pins out of both masks keep their values , a pin in both masks is set (BSRR priority).
+ */
+enumError_t GPIO_Set_PortMask(void *Port , u32 SetMask , u32 ResetMask);
+
+/*
+ * @brief     : Gets the current values of all the pins of a port.
+ * @param[in] : Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[out]: PortValue - Pointer to a variable to store the values , bit n for pin n (1 for high, 0 for low).
+ * @return    : enumError_t - Error status indicating success or failure of reading the port value.
+ * @details   : All the pins are sampled by one read of IDR at the same clock.
+ */
+enumError_t GPIO_Get_PortValue(void *Port , u32 *PortValue);
+
+
+/************************** Inline Fast Path ******************************/
+
+/*
+ * The validated functions above are for the dynamic callers (Ports & pins read from tables at runtime) ,
+ * the inline functions below are for the compile time constants :
+ * No validation & no call , a constant port & pin compile to the store in BSRR (Or the load of IDR) only.
+ * GPIO_WRITE_CONST & GPIO_READ_CONST check the constant pin & state at compile time , GPIO_FAST_CHECK of
+ * CFG/GPIO_Cfg.h checks all the arguments at runtime in the debug builds.
+ *
+ *   GPIO_WRITE_CONST(GPIO_PORTA , GPIO_PIN5 , GPIO_SET_PIN);       --> *(GPIOA_BSRR) = 1 << 5
+ */
+
+#if GPIO_FAST_CHECK == GPIO_ENABLE
+/*
+ * @brief    : Called by the fast path on a wrong argument when GPIO_FAST_CHECK is enabled.
+ * @param[in]: None
+ * @return   : None
+ * @details  : Never returns , put a breakpoint in it & the call stack shows the wrong caller.
+ */
+void GPIO_FastCheckFailed(void);
+
+#define GPIO_FAST_ASSERT(Condition)		do { if(!(Condition)) { GPIO_FastCheckFailed(); } } while(0)
+#else
+#define GPIO_FAST_ASSERT(Condition)		((void)0)
+#endif
+
+/*
+ * @brief    : Sets the value of a GPIO pin without validation.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: PinNum - The number of the pin (GPIO_PIN0 --> GPIO_PIN15).
+ * @param[in]: PinState - GPIO_SET_PIN or GPIO_RESET_PIN.
+ * @return   : None
+ */
+static inline void GPIO_WriteFast(void *Port , u32 PinNum , u32 PinState)
+{
+	GPIO_FAST_ASSERT( GPIO_IS_VALID_PORT(Port) && (PinNum <= GPIO_PIN15) &&
+			( (PinState == GPIO_SET_PIN) || (PinState == GPIO_RESET_PIN) ) );
+
+	GPIO_REG(Port , GPIO_BSRR_INDEX) = PinState << PinNum;
+}
+
+/*
+ * @brief    : Gets the value of a GPIO pin without validation.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: PinNum - The number of the pin (GPIO_PIN0 --> GPIO_PIN15).
+ * @return   : u32 - 1 for high , 0 for low.
+ */
+static inline u32 GPIO_ReadFast(void *Port , u32 PinNum)
+{
+	GPIO_FAST_ASSERT( GPIO_IS_VALID_PORT(Port) && (PinNum <= GPIO_PIN15) );
+
+	return ( GPIO_REG(Port , GPIO_IDR_INDEX) >> PinNum ) & GPIO_SET_PIN;
+}
+
+/*
+ * @brief    : Sets & resets a group of pins of a port with one write of BSRR without validation.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: SetMask - Pins to be set (Up to GPIO_ALL_PINS_MASK).
+ * @param[in]: ResetMask - Pins to be reset (Up to GPIO_ALL_PINS_MASK) , a pin in both masks is set.
+ * @return   : None
+ */
+static inline void GPIO_WritePortFast(void *Port , u32 SetMask , u32 ResetMask)
+{
+	GPIO_FAST_ASSERT( GPIO_IS_VALID_PORT(Port) && ( ( (SetMask | ResetMask) & ~GPIO_ALL_PINS_MASK ) == 0 ) );
+
+	GPIO_REG(Port , GPIO_BSRR_INDEX) = (ResetMask << GPIO_BSRR_RESET_SHIFT) | SetMask;
+}
+
+/*
+ * @brief    : Gets the values of all the pins of a port without validation.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @return   : u32 - Bit n for pin n (1 for high , 0 for low).
+ */
+static inline u32 GPIO_ReadPortFast(void *Port)
+{
+	GPIO_FAST_ASSERT( GPIO_IS_VALID_PORT(Port) );
+
+	return GPIO_REG(Port , GPIO_IDR_INDEX) & GPIO_ALL_PINS_MASK;
+}
+
+/* Fast path with the constant pin & state checked at compile time */
+#define GPIO_WRITE_CONST(Port , PinNum , PinState)														\
+	do																									\
+	{																									\
+		_Static_assert( (PinNum) <= GPIO_PIN15 , "GPIO pin out of GPIO_PIN0 --> GPIO_PIN15");			\
+		_Static_assert( ((PinState) == GPIO_SET_PIN) || ((PinState) == GPIO_RESET_PIN) ,				\
+				"GPIO pin state must be GPIO_SET_PIN or GPIO_RESET_PIN");								\
+		GPIO_WriteFast((Port) , (PinNum) , (PinState));													\
+	} while(0)
+
+#define GPIO_READ_CONST(Port , PinNum , Value)															\
+	do																									\
+	{																									\
+		_Static_assert( (PinNum) <= GPIO_PIN15 , "GPIO pin out of GPIO_PIN0 --> GPIO_PIN15");			\
+		(Value) = GPIO_ReadFast((Port) , (PinNum));														\
+	} while(0)
 
 
 #endif /* GPIO_H_ */
@@ -0,0 +1,44 @@
+/*
+ ============================================================================
+ Name        : IWDG.h
+ Author      : Farah Mohey
+ Description : Header file for IWDG (Independent watchdog for STM32F401xC)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef MCAL_IWDG_H_
+#define MCAL_IWDG_H_
+
+/******************************* Includes *************************************/
+#include "LIB/Std_Types.h"
+#include "LIB/Masks.h"
+#include "LIB/Errors_enum.h"
+#include "CFG/IWDG_Cfg.h"
+
+/******************************* Definitions ***********************************/
+
+/* Longest timeout : 4096 counts of LSI / 256 */
+#define IWDG_MAX_TIMEOUT_MS		((0x1000UL * 256UL * 1000UL) / IWDG_LSI_FREQUENCY_HZ)
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Starts the independent watchdog.
+ * @param   : TimeoutMs - Time without refresh after which the microcontroller is reset (1 to IWDG_MAX_TIMEOUT_MS).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The smallest prescaler giving the timeout is selected , the timeout is rounded down to whole counts.
+ * 				Once started the watchdog can't be stopped (Only by a reset) & keeps counting in sleep mode.
+ */
+enumError_t IWDG_Init(u32 TimeoutMs);
+
+/*
+ * @brief   : Reloads the counter of the watchdog.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Must be called more often than the timeout to prevent the reset.
+ */
+enumError_t IWDG_Refresh(void);
+
+
+#endif /* MCAL_IWDG_H_ */
@@ -23,6 +23,10 @@
 #define PRIORITY_GROUP3		0x05FA0600 /*[1] bits Preempt Group &  [3] bits Subpriority Group*/
 #define PRIORITY_GROUP5		0x05FA0700 /*[0] bits Preempt Group &  [4] bits Subpriority Group*/
 
+/*System exceptions which priority is configurable by NVIC_SetSystemPriority */
+#define NVIC_SYS_PENDSV		14	/*PendSV --> Pendable request for system service */
+#define NVIC_SYS_SYSTICK	15	/*SysTick timer */
+
 /*************************** Functions Prototypes *****************************/
 
 /*
@@ -75,12 +79,21 @@ enumError_t NVIC_GetPending_IRQ(IRQn_t IRQn, u8 *Ptr_IRQ);
  */
 enumError_t NVIC_GetActive_IRQ(IRQn_t IRQn, u8 *Ptr_IRQ);
 
+/*
+ * @brief    : Set the Priority Grouping
+ * @param[in]: GroupPriority - Group priority value (PRIORITY_GROUP0 ... PRIORITY_GROUP5)
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Writes PRIGROUP of AIRCR , called once at startup before setting the priorities
+ * 				(PRIORITY_GROUP0 is the reset value).
+ */
+enumError_t NVIC_SetPriorityGrouping(u32 GroupPriority);
+
 /*
  * @brief    : Set Interrupt Priority
  * @param[in]: IRQn - Interrupt number
  * @param[in]: PreemptGroup - Preemption priority group
  * @param[in]: SubpriorityGroup - Subpriority group
- * @param[in]: GroupPriority - Group priority value
+ * @param[in]: GroupPriority - Group priority value , must be the grouping set by NVIC_SetPriorityGrouping
  * @return   : enumError_t - Indicating Status of the operation
  * @details  : Sets the priority level for the specified NVIC interrupt.
  */
@@ -104,6 +117,32 @@ enumError_t NVIC_GetPriority(IRQn_t IRQn, u8 *Ptr_priorityLEV);
  * 				For example, a value of 0x03 specifies interrupt IRQ3.
  */
 enumError_t NVIC_SetSoftware_Interrupt(IRQn_t IRQn);
+/*
+ * @brief    : Set System Exception Priority
+ * @param[in]: SysException - NVIC_SYS_PENDSV or NVIC_SYS_SYSTICK
+ * @param[in]: PreemptGroup - Preemption priority group
+ * @param[in]: SubpriorityGroup - Subpriority group
+ * @param[in]: GroupPriority - Group priority value , must be the grouping set by NVIC_SetPriorityGrouping
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Same as NVIC_SetPriority for the system exceptions which are configured in the system control block.
+ */
+enumError_t NVIC_SetSystemPriority(u8 SysException, u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority );
+
+/*
+ * @brief    : Set PendSV Pending
+ * @param[in]: None
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Requests the PendSV exception , its handler runs once no higher priority exception is active.
+ */
+enumError_t NVIC_SetPending_PendSV(void);
+
+/*
+ * @brief    : Resets the microcontroller
+ * @param[in]: None
+ * @return   : None - It never returns
+ * @details  : Requests a system reset (SYSRESETREQ of AIRCR) keeping the priority grouping.
+ */
+void NVIC_SystemReset(void);
 
 #endif /* MCAL_NVIC_H_ */
 
@@ -14,6 +14,7 @@
 #include  	"LIB/Std_Types.h"
 #include  	"LIB/Masks.h"
 #include  	"LIB/Errors_enum.h"
+#include  	"CFG/RCC_Cfg.h"
 
 
 
@@ -112,6 +113,12 @@
 #define APB2_TIM11	BIT18_MASK
 
 
+/**************************   Types Declaration   *****************************/
+
+/*Callback notified after HCLK changed (System clock switched or AHB prescaler changed) */
+typedef void (*RCC_CBF_t)(void);
+
+
 /************************** Functions Prototypes *******************************/
 /*
  * @brief    : Set Clock ON.
@@ -141,6 +148,7 @@ enumError_t RCC_READ_ClockReadyState(u32 READY_CLK);
  * @param	 : SYSCLK The system clock source to be selected. It can be SYSCLK_HSI_MASK, SYSCLK_HSE_MASK, or SYSCLK_PLL_MASK.
  * @return   : enumError_t , Error status indicating the success or failure of selecting the system clock.
  * @details  : This function selects the system clock source among the available options: HSI, HSE, or PLL.
+ *             It waits for the switch then notifies the clock change callbacks (RCC_ClkNotReady --> Not switched).
  */
 enumError_t RCC_Select_SysClk(u32 SYSCLK);
 
@@ -153,6 +161,32 @@ enumError_t RCC_Select_SysClk(u32 SYSCLK);
  */
 u32 RCC_Read_SysClk(void);
 
+/*
+ * @brief    : Get System Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , SYSCLK in Hz.
+ * @details  : Calculated from the registers : The clock switched to (HSI 16 MHz , HSE RCC_HSE_FREQUENCY_HZ ,
+ *             or PLL --> Source / PLLM * PLLN / PLLP).
+ */
+u32 RCC_Get_SysClkFreq(void);
+
+/*
+ * @brief    : Get AHB Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , HCLK in Hz (Clock of the processor , the SysTick & the DWT cycle counter).
+ * @details  : SYSCLK divided by the AHB prescaler.
+ */
+u32 RCC_Get_HclkFreq(void);
+
+/*
+ * @brief    : Add a callback notified when HCLK changes.
+ * @param	 : CallBack , Function called after the system clock is switched or the AHB prescaler is changed.
+ * @return   : enumError_t , Error status (Nok --> RCC_MAX_CLOCK_CALLBACKS already added).
+ * @details  : The callbacks are called by RCC_Select_SysClk & RCC_Config_AHB_BusPrescaler in their order of adding ,
+ *             so the drivers (e.g. STK) added first are updated before their users. Adding a callback again has no effect.
+ */
+enumError_t RCC_AddClockChangeCallBack(RCC_CBF_t CallBack);
+
 /*
  * @brief    : Configure PLL Source.
  * @param	 : Copy_PLLSrc The PLL source to be configured. It can be PLL_SRC_HSI or PLL_SRC_HSE.
@@ -189,6 +223,7 @@ enumError_t RCC_Config_APBL_BusPrescaler (u32  APBL_PreScalerValue);
  * @param	 : AHB_PreScalerValue
  * @param	 : It Can be AHB_1 ,AHB_2 ,AHB_4 , AHB_8 , AHB_16 , AHB_64 , AHB_128 , AHB_256 , AHB_512
  * @return   : enumError_t, Error status indicating the success or failure of setting prescaler value.
+ * @details  : The clock change callbacks are notified.
  */
 enumError_t RCC_Config_AHB_BusPrescaler (u32  AHB_PreScalerValue);
 
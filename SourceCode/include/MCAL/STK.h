@@ -25,6 +25,9 @@
 #define STK_AHB_DIS_INT   	0x00000004  /*clk source = Processor CLK --> AHB & DOESN'T ASSERT the SysTick exception request --> 10*/
 #define STK_AHB_ENB_INT  	0x00000006  /*clk source = Processor CLK --> AHB & ASSERT the SysTick exception request--> 11*/
 
+/* Maximum value of the 24 bit RELOAD register */
+#define STK_MAX_RELOAD_VAL	0x00FFFFFF
+
 /*	 Bit 2						  Bit 1
  * 	CLKSOURCE					 TICKINT
  * 0--> AHB/8					0--> Counting down to zero DOES NOT assert the SysTick exception request
@@ -63,6 +66,8 @@ enumError_t STK_Stop(void);
  * 							  STK_AHB_8_ENB_INT ,  STK_AHB_ENB_INT
  * @return  : enumError_t - Indicating Status of the operation if Success or Failure
  * @details : This function configures the SysTick timer according to the provided mode.
+ * 				It reads HCLK from RCC & adds a clock change callback of RCC , so the period set in time units
+ * 				is recalculated whenever the system clock or the AHB prescaler changes (Nok --> No free callback of RCC).
  */
 enumError_t STK_SetConfig(u32 Mode);
 
@@ -73,9 +78,60 @@ enumError_t STK_SetConfig(u32 Mode);
  * @return  : enumError_t - Indicating Status of the operation if Success or Failure
  * @details : This function sets the time interval for the SysTick timer,
  * 				which determines the period between interrupts generated by the timer.
+ * 				The counts are calculated in 64 bits from HCLK read from RCC.
  */
 enumError_t STK_SetTimeMs(u32 TimeMs);
 
+/*
+ * @brief   : Sets the time interval for the SysTick timer in microseconds.
+ * @param   : TimeUs - The time interval in microseconds.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Used for intervals finer than 1 ms or not a whole number of milliseconds (e.g. 250 us or 1500 us).
+ * 				The interval is truncated to whole counts of the SysTick clock.
+ */
+enumError_t STK_SetTimeUs(u32 TimeUs);
+
+/*
+ * @brief   : Sets the RELOAD value of the SysTick timer directly in timer counts.
+ * @param   : ReloadVal - Number of counts of the period - 1 (from 1 to STK_MAX_RELOAD_VAL).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The current value is cleared so the new period starts counting immediately.
+ * 				The period of STK_SetTimeMs / STK_SetTimeUs is kept , it is loaded again when HCLK changes.
+ */
+enumError_t STK_SetReloadVal(u32 ReloadVal);
+
+/*
+ * @brief   : Get Value of LOAD Register - Counts of the current period - 1.
+ * @param   : *Reload_Val - Pointer to store in it the value.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_GET_ReloadVal(u32 *Reload_Val);
+
+/*
+ * @brief   : Get Value of COUNTFLAG - If the timer counted to 0 since the last time it was read.
+ * @param   : *Count_Flag - Pointer to store in it the flag (1 --> counted to 0 , 0 --> not).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Reading the flag clears it.
+ */
+enumError_t STK_GET_CountFlag(u8 *Count_Flag);
+
+/*
+ * @brief   : Gets whether the SysTick runs the period set in time units.
+ * @param   : None
+ * @return  : enumError_t - Ok , STK_PeriodOutOfRange (The period set by STK_SetTimeMs / STK_SetTimeUs doesn't fit in
+ * 				the RELOAD at the HCLK of the last clock change , the previous RELOAD is running).
+ * @details : Cleared by the next period loaded successfully (STK_SetTimeMs / STK_SetTimeUs or a later clock change).
+ */
+enumError_t STK_GetStatus(void);
+
+/*
+ * @brief   : Clears the pending state of the SysTick exception.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Used when the expired period is already handled so the handler should not be executed for it.
+ */
+enumError_t STK_ClearPending(void);
+
 /*
  * @brief   : Get Current Value of VAL Register - Remaining Time for SYSTICK.
  * @param   : *Curr_Val - Pointer to access register and store in it the value.
@@ -92,6 +148,16 @@ enumError_t STK_GET_CurrentVal(u32 *Curr_Val);
  */
 enumError_t STK_SetCallBack(STK_CBF_t CallBack);
 
+/*
+ * @brief   : Adds a callback function for the SysTick timer interrupt.
+ * @param   : CallBack - Pointer to the callback function.
+ * @return  : enumError_t - Indicating Status of the operation (Nok --> STK_MAX_ADDED_CALLBACKS already added).
+ * @details : Lets another user of the SysTick (e.g. Service/SwTimer.c) share the interrupt with the callback of
+ * 				STK_SetCallBack without changing its period. The added callbacks are executed after it in their order ,
+ * 				adding the same callback again has no effect.
+ */
+enumError_t STK_AddCallBack(STK_CBF_t CallBack);
+
 
 /*
  * @brief   : SysTick interrupt handler.
@@ -104,4 +170,23 @@ enumError_t STK_SetCallBack(STK_CBF_t CallBack);
  */
 void SysTick_Handler(void);
 
+/*
+ * @brief   : Gets the time since the SysTick started in microseconds.
+ * @param   : None
+ * @return  : u64 - Microseconds counted by the SysTick (Never wraps around in practice).
+ * @details : The periods counted by the SysTick interrupt + the counts elapsed in the current period ,
+ * 				so the resolution is one count of the SysTick clock & not one tick. Safe from any ISR or runnable
+ * 				without disabling the interrupts. Needs the SysTick interrupt enabled (TICKINT) & not masked for
+ * 				longer than one period. Changing the period or the clock source loses a few counts.
+ */
+u64 STK_GetTimeUs64(void);
+
+/*
+ * @brief   : Gets the time since the SysTick started in milliseconds.
+ * @param   : None
+ * @return  : u32 - Milliseconds counted by the SysTick , wraps around every 2 pwr 32 ms (49.7 days).
+ * @details : Same time of STK_GetTimeUs64 computed with 32 bit operations only.
+ */
+u32 STK_GetTimeMs(void);
+
 #endif /* MCAL_STK_H_ */
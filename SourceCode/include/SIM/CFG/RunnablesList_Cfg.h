@@ -0,0 +1,35 @@
+/*
+ ============================================================================
+ Name        : RunnablesList_Cfg.h
+ Author      : Farah Mohey
+ Description : Header File for Configuring the Runnables List of the Scheduler simulator (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef CFG_RUNNABLESLIST_CFG_H_
+#define CFG_RUNNABLESLIST_CFG_H_
+
+/*
+ * Found before include/CFG/RunnablesList_Cfg.h by the include path of tools/Sched_Sim.sh ,
+ * another configuration is selected by SCHED_SIM_CFG_INC & SCHED_SIM_CFG_SRC.
+ */
+
+/**************************		Types Declaration	 ******************************/
+/* Configure The Runnables Name in this Enum , it is used as index in RunnableList */
+typedef enum
+{
+	SWITCH,
+	app1,
+	app2,
+	Traffic,
+	LCD,
+
+	/*Indicate number of runnables, don't use it */
+	_MaxRunnables
+}RunnablesList_t;
+
+
+
+#endif /* CFG_RUNNABLESLIST_CFG_H_ */
@@ -0,0 +1,22 @@
+/*
+ ============================================================================
+ Name        : Sched_Tick_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file of the tick time of the Scheduler
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+#ifndef CFG_SCHED_TICK_CFG_H_
+#define CFG_SCHED_TICK_CFG_H_
+
+/* Generated by tools/Sched_Tick.py , don't edit it manually */
+
+/*******************************  Definitions  *********************************/
+
+/* Scheduler tick in microseconds : GCD of the periods & delays of RunnableList & the tables of the modes */
+#define TICK_TIME_US			1000
+
+
+
+#endif /* CFG_SCHED_TICK_CFG_H_ */
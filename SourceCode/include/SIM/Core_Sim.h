@@ -0,0 +1,107 @@
+/*
+ ============================================================================
+ Name        : Core_Sim.h
+ Author      : Farah Mohey
+ Description : Header file for the emulated Cortex-M4 core instructions & exceptions (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+#ifndef SIM_CORE_SIM_H_
+#define SIM_CORE_SIM_H_
+
+/******************************* Includes *************************************/
+#include "LIB/Std_Types.h"
+
+/*
+ * Included by LIB/CortexM4_Core.h when CORE_SIM is defined , the same functions are implemented for the host.
+ * The simulation runs in one host thread : An exception is executed as a call of its handler when it is pending ,
+ * not masked by PRIMASK & of a higher priority than the active one (SysTick > PendSV > Thread).
+ */
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Disables all the configurable interrupts (Sets the emulated PRIMASK).
+ */
+void Core_DisableIRQ(void);
+
+/*
+ * @brief   : Enables all the configurable interrupts & executes the pending exceptions.
+ */
+void Core_EnableIRQ(void);
+
+/*
+ * @brief   : Disables all the configurable interrupts & returns the previous emulated PRIMASK.
+ */
+u32 Core_SaveDisableIRQ(void);
+
+/*
+ * @brief   : Restores the emulated PRIMASK saved by Core_SaveDisableIRQ , executes the pending exceptions if enabled.
+ */
+void Core_RestoreIRQ(u32 Primask);
+
+/*
+ * @brief   : Advances the virtual clock till an exception is pending , then executes it if not masked.
+ */
+void Core_WaitForInterrupt(void);
+
+/*
+ * @brief   : Same as Core_WaitForInterrupt , the idle loop has nothing to do till the next interrupt.
+ */
+void Core_Idle(void);
+
+/*
+ * @brief   : Data Memory Barrier , a full fence of the host (Code using it may be tested from several host threads).
+ */
+void Core_DataMemoryBarrier(void);
+
+/*
+ * @brief   : Data Synchronization Barrier , the host accesses are already completed in order.
+ */
+void Core_DataSyncBarrier(void);
+
+/*
+ * @brief   : Gets the number of the exception being executed.
+ * @return  : u32 - 0 --> Thread mode , Otherwise the exception number (14 --> PendSV , 15 --> SysTick).
+ */
+u32 Core_GetActiveException(void);
+
+/*
+ * @brief   : Counts the leading zero bits of the low 32 bits of a word.
+ * @param   : Value - Word to be scanned.
+ * @return  : u32 - Position of the most significant set bit counted from bit 31 (32 --> Value is zero).
+ */
+u32 Core_CountLeadingZeros(u32 Value);
+
+/*
+ * @brief   : Sets bits of a word shared with the exceptions.
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be set.
+ * @details : Exceptions are executed only at the emulated interrupt points so a plain update is atomic.
+ */
+void Core_AtomicSetBits(volatile u32 *Word , u32 Mask);
+
+/*
+ * @brief   : Clears bits of a word shared with the exceptions.
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be cleared.
+ */
+void Core_AtomicClearBits(volatile u32 *Word , u32 Mask);
+
+/*
+ * @brief   : Sets an exception pending & executes it if allowed.
+ * @param   : Exception - Exception number (14 --> PendSV , 15 --> SysTick).
+ * @return  : None
+ */
+void Core_Sim_SetPending(u32 Exception);
+
+/*
+ * @brief   : Clears the pending state of an exception.
+ * @param   : Exception - Exception number (14 --> PendSV , 15 --> SysTick).
+ * @return  : None
+ */
+void Core_Sim_ClearPending(u32 Exception);
+
+
+#endif /* SIM_CORE_SIM_H_ */
@@ -0,0 +1,28 @@
+/*
+ ============================================================================
+ Name        : DWT_Sim.h
+ Author      : Farah Mohey
+ Description : Header file for the simulated DWT cycle counter (Host build)
+ Created	 : 22-Apr-24
+ ============================================================================
+ */
+
+#ifndef SIM_DWT_SIM_H_
+#define SIM_DWT_SIM_H_
+
+/******************************* Includes *************************************/
+#include "MCAL/DWT.h"
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Advances the simulated cycle counter.
+ * @param   : Cycles - Number of cycles to add to the counter.
+ * @return  : None
+ * @details : The host build links DWT_Sim.c instead of DWT.c , the simulation or the unit under test
+ * 				calls this function to model the time consumed by the code.
+ */
+void DWT_Sim_AddCycles(u32 Cycles);
+
+
+#endif /* SIM_DWT_SIM_H_ */
@@ -0,0 +1,42 @@
+/*
+ ============================================================================
+ Name        : IWDG_Sim.h
+ Author      : Farah Mohey
+ Description : Header file for the simulated independent watchdog (Host build)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef SIM_IWDG_SIM_H_
+#define SIM_IWDG_SIM_H_
+
+/******************************* Includes *************************************/
+#include "MCAL/IWDG.h"
+
+/*
+ * The host build links IWDG_Sim.c instead of IWDG.c . The gaps between the refreshes are measured
+ * on the virtual clock of STK_Sim.c , a gap longer than the timeout is counted as an expiry
+ * (The simulation continues instead of resetting).
+ */
+
+/***************************** Types Declaration *******************************/
+
+/*Refreshes of the simulated watchdog */
+typedef struct
+{
+	u64 TimeoutCycles;		/* Timeout set by IWDG_Init (0 --> not started) */
+	u64 MaxGapCycles;		/* Longest time between two refreshes */
+	u32 Expiries;			/* Refreshes later than the timeout (Resets on the target) */
+} IWDG_Sim_Stats_t;
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Gets the refresh statistics of the simulated watchdog.
+ * @param   : Stats - Pointer to store the statistics in it.
+ * @return  : None
+ */
+void IWDG_Sim_GetStats(IWDG_Sim_Stats_t *Stats);
+
+
+#endif /* SIM_IWDG_SIM_H_ */
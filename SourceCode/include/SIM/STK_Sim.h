@@ -0,0 +1,64 @@
+/*
+ ============================================================================
+ Name        : STK_Sim.h
+ Author      : Farah Mohey
+ Description : Header file for the simulated SysTick on a virtual clock (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+#ifndef SIM_STK_SIM_H_
+#define SIM_STK_SIM_H_
+
+/******************************* Includes *************************************/
+#include "MCAL/STK.h"
+
+/*
+ * The host build links STK_Sim.c instead of STK.c . The registers of the SysTick are variables counting
+ * a virtual clock of CLK_FREQUENCY_MHZ cycles per second , the time passes only when the code calls
+ * STK_Sim_AddCycles (Modeling its execution time) or waits for an interrupt (Core_WaitForInterrupt).
+ * So the simulation runs as fast as the host executes the code whatever the simulated time.
+ */
+
+/***************************** Types Declaration *******************************/
+
+/*Function called when the simulated time reaches its end , it must not return (e.g. longjmp or exit) */
+typedef void (*STK_Sim_EndCBF_t)(void);
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Sets the end of the simulation.
+ * @param   : EndCycles - Virtual clock cycles to be simulated.
+ * @param   : EndCallBack - Function called when the virtual clock reaches EndCycles.
+ * @return  : None
+ */
+void STK_Sim_SetEnd(u64 EndCycles , STK_Sim_EndCBF_t EndCallBack);
+
+/*
+ * @brief   : Advances the virtual clock.
+ * @param   : Cycles - Processor clock cycles consumed by the code.
+ * @return  : None
+ * @details : The SysTick counts down by the cycles (Or by the cycles / 8 for the AHB/8 source) ,
+ * 				each time it reaches zero the SysTick exception is set pending (Executed at once if not masked ,
+ * 				so the rest of the cycles are counted after the preempting handler). The DWT counter is advanced too.
+ */
+void STK_Sim_AddCycles(u32 Cycles);
+
+/*
+ * @brief   : Advances the virtual clock to the next time the SysTick reaches zero.
+ * @param   : None
+ * @return  : None
+ * @details : The simulation ends if the SysTick is stopped or its exception is disabled (No interrupt to wait for).
+ */
+void STK_Sim_RunToExpiry(void);
+
+/*
+ * @brief   : Gets the virtual clock.
+ * @param   : None
+ * @return  : u64 - Processor clock cycles simulated since the start.
+ */
+u64 STK_Sim_GetCycles(void);
+
+
+#endif /* SIM_STK_SIM_H_ */
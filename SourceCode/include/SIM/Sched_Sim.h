@@ -0,0 +1,66 @@
+/*
+ ============================================================================
+ Name        : Sched_Sim.h
+ Author      : Farah Mohey
+ Description : Header file for the virtual time simulator of the Scheduler (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+#ifndef SIM_SCHED_SIM_H_
+#define SIM_SCHED_SIM_H_
+
+/******************************* Includes *************************************/
+#include "Service/Scheduler.h"
+
+/*
+ * The simulator builds the real Service/Scheduler.c for the host with STK_Sim.c , NVIC_Sim.c , RCC_Sim.c , DWT_Sim.c
+ * & IWDG_Sim.c instead of the drivers (tools/Sched_Sim.sh). Sched_Start runs on the virtual clock of STK_Sim.c till the
+ * simulated time ends , then the release counts , drift , overruns , per-tick load & the tick cost
+ * (SCHED_TICK_PROFILING) are reported.
+ *
+ * The simulated RunnableList is configured like the target one (CFG/RunnablesList_Cfg.h , CFG/Sched_Tick_Cfg.h
+ * generated by tools/Sched_Tick.py & a source defining RunnableList) , every callback is a stub consuming
+ * the cycles configured in SchedSimCostList :
+ *
+ *   SCHED_SIM_DEFINE_RUNNABLE(LCD)
+ *   const Runnable_t RunnableList[_MaxRunnables] =
+ *   {
+ *       [LCD] = {.Name = "LCD", .PeriodicityMs = 2, .cb = SCHED_SIM_RUNNABLE(LCD) , .DelayTimeMs = 0},
+ *   };
+ *   const SchedSim_Cost_t SchedSimCostList[_MaxRunnables] =
+ *   {
+ *       [LCD] = {.MinCycles = 2000 , .MaxCycles = 6000},
+ *   };
+ */
+
+/***************************** Types Declaration *******************************/
+
+/*Execution time of a simulated runnable , a pseudo random value between the limits at every call */
+typedef struct
+{
+	u32 MinCycles;
+	u32 MaxCycles;
+} SchedSim_Cost_t;
+
+/***************************** Definitions *************************************/
+
+/* Defines the stub callback of the runnable of index IDX */
+#define SCHED_SIM_DEFINE_RUNNABLE(IDX)	static void SchedSim_Runnable_##IDX(void) { SchedSim_Execute(IDX); }
+
+/* Stub callback of the runnable of index IDX to be set in RunnableList */
+#define SCHED_SIM_RUNNABLE(IDX)			SchedSim_Runnable_##IDX
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief   : Executes a simulated runnable.
+ * @param   : RunnableIdx - Index of the runnable in RunnableList.
+ * @return  : None
+ * @details : Records the release & consumes the configured cycles on the virtual clock
+ * 				(The ticks expiring meanwhile are raised like on the target).
+ */
+void SchedSim_Execute(u32 RunnableIdx);
+
+
+#endif /* SIM_SCHED_SIM_H_ */
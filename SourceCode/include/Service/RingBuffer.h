@@ -0,0 +1,156 @@
+/*
+ ============================================================================
+ Name        : RingBuffer.h
+ Author      : Farah Mohey
+ Description : Header file for the lock-free single producer / single consumer ring buffer
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef SERVICE_RINGBUFFER_H_
+#define SERVICE_RINGBUFFER_H_
+
+/******************************** Includes ************************************/
+#include "LIB/Std_Types.h"
+#include "LIB/Errors_enum.h"
+
+/*
+ * Passes elements of any size from one producer (e.g. an ISR or a DMA completion) to one consumer (e.g. a runnable)
+ * without disabling the interrupts. Each side writes its own index only , the other side only reads it.
+ * The elements are written before the index publishing them (Data Memory Barrier) so the consumer never sees
+ * an element half written.
+ *
+ *   RINGBUFFER_DEFINE(UartRx , u8 , 64)
+ *
+ *   void USART1_IRQHandler(void)        --> RingBuffer_Push(&UartRx , &loc_Byte);
+ *   void Uart_Runnable(void)            --> while (RingBuffer_Pop(&UartRx , &loc_Byte) == Ok) { ... }
+ *
+ * Zero copy : The producer gets the contiguous free elements by RingBuffer_Reserve , writes them in place
+ * (e.g. a DMA transfer) & publishes them by RingBuffer_Commit. The consumer reads them in place by RingBuffer_Peek
+ * & frees them by RingBuffer_Release.
+ */
+
+/***************************** Types Declaration *******************************/
+
+/*Ring buffer , the indices count the elements pushed & popped since the start & wrap around at 2 pwr 32 */
+typedef struct
+{
+	u8  *Storage;		/* Capacity * ElementSize bytes */
+	u32 ElementSize;	/* Size of one element in bytes */
+	u32 Mask;			/* Capacity - 1 , the capacity is a power of two */
+	volatile u32 Head;	/* Elements pushed , written by the producer only */
+	volatile u32 Tail;	/* Elements popped , written by the consumer only */
+} RingBuffer_t;
+
+/***************************** Definitions *************************************/
+
+/* Defines a ring buffer NAME of CAPACITY elements of ELEMENT_TYPE with its storage (No RingBuffer_Init needed) */
+#define RINGBUFFER_DEFINE(NAME , ELEMENT_TYPE , CAPACITY)												\
+	_Static_assert( ((CAPACITY) > 1) && (((CAPACITY) & ((CAPACITY) - 1)) == 0) ,						\
+			"Capacity of the ring buffer " #NAME " must be a power of two");							\
+	static ELEMENT_TYPE NAME##_Storage[CAPACITY];														\
+	static RingBuffer_t NAME = { (u8 *)NAME##_Storage , sizeof(ELEMENT_TYPE) , (CAPACITY) - 1 , 0 , 0 }
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief    : Initializes a ring buffer on a given storage.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Storage - Buffer of Capacity * ElementSize bytes , aligned to the elements.
+ * @param[in]: ElementSize - Size of one element in bytes.
+ * @param[in]: Capacity - Number of elements , a power of two (2 , 4 , 8 ...).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Called before the producer & the consumer use it , the buffer is empty.
+ */
+enumError_t RingBuffer_Init(RingBuffer_t *Ring , void *Storage , u32 ElementSize , u32 Capacity);
+
+/*
+ * @brief    : Pushes one element (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Element - Pointer to the element to be copied in.
+ * @return   : enumError_t - Ok , RingBuffer_Full (The element is dropped).
+ */
+enumError_t RingBuffer_Push(RingBuffer_t *Ring , const void *Element);
+
+/*
+ * @brief    : Pops one element (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Element - Pointer to store the oldest element in it.
+ * @return   : enumError_t - Ok , RingBuffer_Empty.
+ */
+enumError_t RingBuffer_Pop(RingBuffer_t *Ring , void *Element);
+
+/*
+ * @brief    : Pushes an array of elements at once (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Elements - Pointer to the elements to be copied in.
+ * @param[in]: Count - Number of elements.
+ * @param[out]: Pushed - Pointer to store the number of elements pushed (NULL_PTR --> not needed).
+ * @return   : enumError_t - Ok , RingBuffer_Full (Only the elements fitting are pushed).
+ * @details  : The elements are copied in at most two blocks & published by one index update.
+ */
+enumError_t RingBuffer_PushBatch(RingBuffer_t *Ring , const void *Elements , u32 Count , u32 *Pushed);
+
+/*
+ * @brief    : Pops up to a number of elements at once (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Elements - Pointer to store the elements in it (Room for Count elements).
+ * @param[in]: Count - Maximum number of elements.
+ * @param[out]: Popped - Pointer to store the number of elements popped.
+ * @return   : enumError_t - Ok , RingBuffer_Empty (Nothing popped).
+ */
+enumError_t RingBuffer_PopBatch(RingBuffer_t *Ring , void *Elements , u32 Count , u32 *Popped);
+
+/*
+ * @brief    : Gets the contiguous free elements to be written in place (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Region - Pointer to store the address of the first free element in it.
+ * @param[out]: Count - Pointer to store the number of contiguous free elements (Till the end of the storage).
+ * @return   : enumError_t - Ok , RingBuffer_Full (Count is 0).
+ * @details  : Nothing is published till RingBuffer_Commit , the free space wrapping to the start of the storage
+ *             is reserved by a second call after the commit.
+ */
+enumError_t RingBuffer_Reserve(RingBuffer_t *Ring , void **Region , u32 *Count);
+
+/*
+ * @brief    : Publishes the elements written in the reserved region (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Count - Number of elements written , at most the reserved count.
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> More than the free elements).
+ */
+enumError_t RingBuffer_Commit(RingBuffer_t *Ring , u32 Count);
+
+/*
+ * @brief    : Gets the contiguous elements to be read in place (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Region - Pointer to store the address of the oldest element in it.
+ * @param[out]: Count - Pointer to store the number of contiguous elements (Till the end of the storage).
+ * @return   : enumError_t - Ok , RingBuffer_Empty (Count is 0).
+ * @details  : The elements stay in the buffer till RingBuffer_Release.
+ */
+enumError_t RingBuffer_Peek(RingBuffer_t *Ring , const void **Region , u32 *Count);
+
+/*
+ * @brief    : Frees the oldest elements read in place (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Count - Number of elements , at most the peeked count.
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> More than the stored elements).
+ */
+enumError_t RingBuffer_Release(RingBuffer_t *Ring , u32 Count);
+
+/*
+ * @brief    : Gets the number of stored elements.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @return   : u32 - Elements pushed & not popped yet (A snapshot , it may change at once from the other side).
+ */
+u32 RingBuffer_GetCount(const RingBuffer_t *Ring);
+
+/*
+ * @brief    : Gets the number of free elements.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @return   : u32 - Elements which can be pushed (A snapshot , it may change at once from the other side).
+ */
+u32 RingBuffer_GetFree(const RingBuffer_t *Ring);
+
+
+#endif /* SERVICE_RINGBUFFER_H_ */
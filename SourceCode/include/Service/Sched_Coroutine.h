@@ -0,0 +1,86 @@
+/*
+ ============================================================================
+ Name        : Sched_Coroutine.h
+ Author      : Farah Mohey
+ Description : Header file for the stackless coroutines of the Scheduler runnables
+ Created	 : 24-Apr-24
+ ============================================================================
+ */
+
+
+#ifndef SERVICE_SCHED_COROUTINE_H_
+#define SERVICE_SCHED_COROUTINE_H_
+
+
+/******************************** Includes ************************************/
+#include "LIB/Std_Types.h"
+#include "Service/Scheduler.h"
+
+/*
+ * A long runnable is written as one sequence of steps & gives the CPU back between them by the macros below ,
+ * the next call of its callback (Next release or activation) resumes it after the macro that returned.
+ * No stack is saved : The coroutine returns from its callback & only the resume point is kept in Sched_Coroutine_t.
+ *
+ * Rules :
+ *   - Local variables are lost at every yield , keep the variables used across the yields static.
+ *   - A switch statement can't contain a yield (The macros are built on the switch of SCHED_CO_BEGIN).
+ *   - The runnable must be periodic (The wait is checked at every release) or event triggered & activated
+ *     again by the source of the awaited event.
+ *
+ * Ex :
+ *   void LCD_Runnable(void)
+ *   {
+ *       static Sched_Coroutine_t loc_Co;
+ *
+ *       SCHED_CO_BEGIN(&loc_Co);
+ *       LCD_SendCommand(LCD_CLEAR);
+ *       SCHED_WAIT_MS(2);
+ *       LCD_SendCommand(LCD_ENTRY_MODE);
+ *       SCHED_YIELD();
+ *       ...
+ *       SCHED_CO_END();
+ *   }
+ */
+
+/***************************** Types Declaration *******************************/
+
+/*State of one coroutine , zero initialized --> starts from SCHED_CO_BEGIN */
+typedef struct
+{
+	u16 Line;		/* Line of the resume point , 0 --> the beginning */
+	u32 WakeTimeMs;	/* Time to resume a SCHED_WAIT_MS , compared with Sched_GetTimeMs */
+} Sched_Coroutine_t;
+
+/*Event awaited by SCHED_WAIT_EVENT , set by SCHED_SET_EVENT (From a runnable or an ISR , a byte write is atomic) */
+typedef volatile u8 Sched_Event_t;
+
+/***************************** Definitions *************************************/
+
+/* Starts the body of the coroutine , jumps to the resume point of the previous call */
+#define SCHED_CO_BEGIN(CO)		{ Sched_Coroutine_t *const _SchedCo = (CO); switch (_SchedCo->Line) { case 0:
+
+/* Ends the body of the coroutine , the next call starts it again from the beginning */
+#define SCHED_CO_END()			} _SchedCo->Line = 0; }
+
+/* Restarts the coroutine from the beginning at the next call */
+#define SCHED_CO_RESTART()		do { _SchedCo->Line = 0; return; } while (0)
+
+/* Returns to the scheduler & resumes after it at the next call */
+#define SCHED_YIELD()			do { _SchedCo->Line = __LINE__; return; case __LINE__: ; } while (0)
+
+/* Returns to the scheduler till the condition is true , checked at every call */
+#define SCHED_WAIT_UNTIL(COND)	do { _SchedCo->Line = __LINE__; case __LINE__: if (!(COND)) { return; } } while (0)
+
+/* Returns to the scheduler till MS milliseconds pass (Resumed at the first call after them)
+ * (s32) of the difference keeps the comparison valid when the time wraps around */
+#define SCHED_WAIT_MS(MS)		do { _SchedCo->WakeTimeMs = Sched_GetTimeMs() + (u32)(MS);	\
+								 SCHED_WAIT_UNTIL((s32)(Sched_GetTimeMs() - _SchedCo->WakeTimeMs) >= 0); } while (0)
+
+/* Returns to the scheduler till the event is set , then clears it */
+#define SCHED_WAIT_EVENT(EVENT)	do { SCHED_WAIT_UNTIL((EVENT) != 0); (EVENT) = 0; } while (0)
+
+/* Sets an event to resume the coroutine waiting for it */
+#define SCHED_SET_EVENT(EVENT)	((EVENT) = 1)
+
+
+#endif /* SERVICE_SCHED_COROUTINE_H_ */
@@ -18,9 +18,37 @@
 #include "LIB/Errors_enum.h"
 #include "MCAL/STK.h"
 #include "CFG/RunnablesList_Cfg.h"
+#include "CFG/Sched_Cfg.h"
+#include "CFG/Sched_Tick_Cfg.h"
 
 /***************************** Definitions *************************************/
-#define TICK_TIME_MS 2
+/* The tick time TICK_TIME_US is generated by tools/Sched_Tick.py in CFG/Sched_Tick_Cfg.h
+ * (GCD of the periods & delays of RunnableList) */
+
+/* Catch-up policies of a runnable released late (Its release ticks passed while other runnables were executing) */
+#define SCHED_CATCHUP_ALL		0	/* Execute every missed release back-to-back (Default) */
+#define SCHED_CATCHUP_SKIP		1	/* Execute once for the latest release & drop the missed ones */
+#define SCHED_CATCHUP_COALESCE	2	/* Execute once , the callback reads the dropped releases by Sched_GetMissedReleases */
+
+/* Priorities of the runnables */
+#define SCHED_PRIORITY_BACKGROUND	0	/* Executed cooperatively by the loop of Sched_Start (Default) */
+#define SCHED_PRIORITY_HIGH			1	/* Released from the SysTick & executed by PendSV preempting the background runnables */
+
+/* Triggers of the runnables */
+#define SCHED_TRIGGER_PERIODIC	0	/* Released by time every PeriodicityMs + PeriodicityUs (Default) */
+#define SCHED_TRIGGER_EVENT		1	/* Released by Sched_ActivateRunnable , e.g. from an ISR */
+
+/* Actions returned by the handler of a runnable over its execution budget */
+#define SCHED_BUDGET_CONTINUE	0	/* Only counted , the runnable keeps running & being released */
+#define SCHED_BUDGET_SUSPEND	1	/* Not released anymore once it returns (Like Sched_RemoveRunnable) */
+#define SCHED_BUDGET_RESET		2	/* Resets the microcontroller at once */
+
+/* Maximum number of event triggered runnables , one bit of the ready bitmap each */
+#define SCHED_MAX_EVENT_RUNNABLES	32
+
+/* Options of the features in Sched_Cfg.h */
+#define SCHED_ENABLE	1
+#define SCHED_DISABLE	0
 
 /***************************** Types Declaration *******************************/
 
@@ -33,12 +61,71 @@ typedef struct
 {
 
 	char   *Name;		 /* Name or ID of the runnable task */
-	u32    PeriodicityMs;	    /* Periodicity of the task in milliseconds */
-	u32    DelayTimeMs;
+	u32    PeriodicityMs;	    /* Periodicity of the task in milliseconds , 0 --> one shot task (If PeriodicityUs = 0 too) */
+	u32    DelayTimeMs;			/* Delay of the first release of the task in milliseconds */
 	RunnableCB_t	cb;		    /* Callback function for the task */
+	u8     CatchUpPolicy;		/* Behavior when the task is released late : SCHED_CATCHUP_ALL , SKIP or COALESCE */
+	u8     Priority;			/* SCHED_PRIORITY_BACKGROUND or SCHED_PRIORITY_HIGH (Needs SCHED_PREEMPTIVE_MODE) */
+	u8     Trigger;				/* SCHED_TRIGGER_PERIODIC or SCHED_TRIGGER_EVENT (Periodicity , DelayTime & CatchUpPolicy are not used) */
+	u32    PeriodicityUs;		/* Microseconds added to PeriodicityMs , for periods finer than 1 ms (e.g. 250 us) */
+	u32    DelayTimeUs;			/* Microseconds added to DelayTimeMs */
+	u32    WcetUs;				/* Worst case execution time in microseconds for SCHED_SCHEDULABILITY_CHECK , 0 --> not declared */
+	u32    BudgetUs;			/* Execution budget in microseconds for SCHED_BUDGET_ENFORCEMENT , 0 --> not enforced */
 
 } Runnable_t;
 
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+/*Cost of the background scheduler ticks in processor clock cycles
+ *(Callbacks of the released runnables & the preempting high priority ticks included) */
+typedef struct
+{
+	u32 Count;			/* Number of measured ticks */
+	u32 MaxCycles;		/* Longest tick */
+	u32 AvgCycles;		/* Average tick */
+} Sched_TickStats_t;
+#endif
+
+#if SCHED_PROFILING == SCHED_ENABLE
+/*Execution time statistics of a runnable in processor clock cycles */
+typedef struct
+{
+	u32 Count;			/* Number of executions of the runnable */
+	u32 MinCycles;		/* Shortest execution */
+	u32 MaxCycles;		/* Longest execution */
+	u32 AvgCycles;		/* Average execution */
+} Sched_RunnableStats_t;
+#endif
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*Histogram of the release latency of a runnable , from the start of its release tick to the start of its callback */
+typedef struct
+{
+	u32 Counts[SCHED_JITTER_BUCKETS];	/* Counts[i] --> Releases started i * SCHED_JITTER_BUCKET_US to (i + 1) * SCHED_JITTER_BUCKET_US late
+										 * The last bucket counts all the releases later than its start */
+	u32 MaxLatencyCycles;				/* Longest latency in processor clock cycles */
+} Sched_JitterHistogram_t;
+
+/*Function called by Sched_DumpJitterHistograms for every runnable in use */
+typedef void (*Sched_JitterDumpCB_t)(u32 RunnableIdx , const char *Name , const Sched_JitterHistogram_t *Histogram);
+#endif
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+/*Handler of a runnable over its budget , called from the SysTick while the runnable is still running
+ *Returns SCHED_BUDGET_CONTINUE , SCHED_BUDGET_SUSPEND or SCHED_BUDGET_RESET */
+typedef u8 (*Sched_BudgetHandler_t)(u32 RunnableIdx);
+#endif
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+/*Result of the schedulability check of the periodic runnables */
+typedef struct
+{
+	u32 UtilizationPerMille;	/* Sum of WCET / period (1000 --> the CPU is fully used) */
+	u32 PeakTickLoadPerMille;	/* Worst load of one tick : Its releases + the work left by the previous ticks */
+	u32 PeakTick;				/* Tick of the hyperperiod with the worst load , from the tick of the check */
+	u32 HyperperiodTicks;		/* LCM of the periods in ticks (0 --> longer than 2 pwr 32 ticks) */
+} Sched_Schedulability_t;
+#endif
+
 /**************************Functions Prototypes ******************************/
 
 /*
@@ -46,6 +133,8 @@ typedef struct
  * @param[in]: None.
  * @return   : enumError_t - Error status indicating success or failure.
  * @details  : Initializes the scheduler by configuring the system timer and setting the tick time.
+ *             When SCHED_SCHEDULABILITY_CHECK is enabled it returns Sched_NotSchedulable if the declared WCET
+ *             of the runnables don't fit in SCHED_LOAD_LIMIT_PERMILLE (The runnables are set up anyway).
  */
 enumError_t Sched_Init(void);
 
@@ -57,8 +146,209 @@ enumError_t Sched_Init(void);
  * @details  : Starts the scheduler by enabling the system timer interrupts
  * 				& Entering an infinite loop where it checks for pending ticks & Executes the scheduler function accordingly
  *             	  Task should be created between Init and start.
+ *             	  In tickless mode the CPU sleeps till the nearest release instead of waking up every tick.
  */
 enumError_t Sched_Start(void);
+/*
+ * @brief    : Adds a runnable at runtime.
+ * @param[in]: Runnable - Pointer to the runnable configuration , it must stay valid till the runnable is removed.
+ * @param[out]: RunnableIdx - Pointer to store the index given to the runnable (To remove it or read its statistics).
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free slot in the pool
+ *             or all the SCHED_MAX_EVENT_RUNNABLES bits are used by event triggered runnables).
+ * @details  : The runnable takes a slot of the pool of SCHED_DYNAMIC_RUNNABLES slots , no dynamic memory is used.
+ *             Its first release is after DelayTimeMs + DelayTimeUs , a runnable with a period of 0 is removed automatically after it runs.
+ *             Times which are not multiple of TICK_TIME_US are rounded up to the next tick.
+ *             Can be called from a background runnable or from the main before Sched_Start ,
+ *             and for SCHED_PRIORITY_HIGH runnables from a high priority runnable as well.
+ */
+enumError_t Sched_AddRunnable(const Runnable_t *Runnable , u32 *RunnableIdx);
+
+/*
+ * @brief    : Removes a runnable at runtime.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The runnable is not released anymore & its slot returns to the pool.
+ *             It can remove itself from its callback , the slot is freed when the callback returns.
+ *             Same calling contexts of Sched_AddRunnable.
+ */
+enumError_t Sched_RemoveRunnable(u32 RunnableIdx);
+
+/*
+ * @brief    : Activates an event triggered runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> Not an event triggered runnable).
+ * @details  : Sets the ready bit of the runnable without disabling the interrupts , so it can be called from any ISR.
+ *             The runnable is executed once by its level (The loop of Sched_Start or PendSV for SCHED_PRIORITY_HIGH)
+ *             whatever the number of activations before it runs. Ready runnables are executed by the order of their ready bit ,
+ *             the event runnables of RunnableList first in their order then the added ones.
+ */
+enumError_t Sched_ActivateRunnable(u32 RunnableIdx);
+
+/*
+ * @brief    : Gets the scheduler time of the calling runnable.
+ * @param[in]: None.
+ * @return   : u32 - Time in milliseconds of the tick processed by the level of the caller , wraps around every 2 pwr 32 ms.
+ * @details  : Used by SCHED_WAIT_MS of Service/Sched_Coroutine.h. It has the resolution of TICK_TIME_US rounded down to 1 ms.
+ */
+u32 Sched_GetTimeMs(void);
+
+/*
+ * @brief    : Gets the number of overruns of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Overruns - Pointer to store the number of releases executed or dropped at least one tick late.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetOverrunCount(u32 RunnableIdx , u32 *Overruns);
+
+/*
+ * @brief    : Gets the releases dropped before the current execution of a SCHED_CATCHUP_COALESCE runnable.
+ * @param[in]: None.
+ * @return   : u32 - Number of missed releases coalesced in the current call (0 --> released on time).
+ * @details  : Valid only when called from the callback of the runnable.
+ */
+u32 Sched_GetMissedReleases(void);
+
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+/*
+ * @brief    : Gets the cycles spent by the scheduler in its ticks.
+ * @param[out]: Stats - Pointer to store the statistics in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_TICK_PROFILING is enabled , Sched_Init starts the DWT cycle counter.
+ *             Build the RunnableList with runnables of empty callbacks to benchmark the tick against _MaxRunnables.
+ */
+enumError_t Sched_GetTickStats(Sched_TickStats_t *Stats);
+
+/*
+ * @brief    : Clears the cycles spent by the scheduler in its ticks.
+ * @param[in]: None.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetTickStats(void);
+#endif
+
+#if SCHED_PROFILING == SCHED_ENABLE
+/*
+ * @brief    : Gets the execution time statistics of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Stats - Pointer to store the statistics in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_PROFILING is enabled , Sched_Init starts the DWT cycle counter.
+ */
+enumError_t Sched_GetRunnableStats(u32 RunnableIdx , Sched_RunnableStats_t *Stats);
+
+/*
+ * @brief    : Clears the execution time statistics of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetRunnableStats(u32 RunnableIdx);
+#endif
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+/*
+ * @brief    : Gets the CPU load over the last completed window.
+ * @param[in]: WindowIdx - Index of the window in SCHED_LOAD_WINDOWS_MS.
+ * @param[out]: LoadPerMille - Pointer to store the load in it (0 --> idle , 1000 --> fully loaded).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_LOAD_MONITOR is enabled. The load is published by the scheduler
+ *             as one halfword so it can be read from any runnable or ISR without locks.
+ *             Interrupts served while idle are counted idle.
+ */
+enumError_t Sched_GetCpuLoad(u32 WindowIdx , u16 *LoadPerMille);
+
+/*
+ * @brief    : Gets the highest load of the shortest window since the start or Sched_ResetPeakCpuLoad.
+ * @param[out]: LoadPerMille - Pointer to store the load in it (0 --> idle , 1000 --> fully loaded).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetPeakCpuLoad(u16 *LoadPerMille);
+
+/*
+ * @brief    : Restarts the tracking of the peak load.
+ * @param[in]: None.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetPeakCpuLoad(void);
+#endif
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*
+ * @brief    : Gets the release latency histogram of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Histogram - Pointer to store a copy of the histogram in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_JITTER is enabled , only the periodic releases are measured.
+ */
+enumError_t Sched_GetJitterHistogram(u32 RunnableIdx , Sched_JitterHistogram_t *Histogram);
+
+/*
+ * @brief    : Clears the release latency histogram of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetJitterHistogram(u32 RunnableIdx);
+
+/*
+ * @brief    : Passes the release latency histogram of every runnable in use to a function.
+ * @param[in]: DumpCB - Function printing or sending the histogram (e.g. over UART from a low rate runnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_DumpJitterHistograms(Sched_JitterDumpCB_t DumpCB);
+#endif
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+/*
+ * @brief    : Checks if the periodic runnables in use fit in the CPU.
+ * @param[out]: Report - Pointer to store the utilization & the worst tick load in it (NULL_PTR --> not needed).
+ * @return   : enumError_t - Ok , Sched_NotSchedulable (Utilization or worst tick load above SCHED_LOAD_LIMIT_PERMILLE).
+ * @details  : Called by Sched_Init with the declared WcetUs. In a calibration build (SCHED_CALIBRATION) the longest
+ *             measured execution replaces a shorter or undeclared WcetUs , so it is called again from a background
+ *             runnable after the worst cases ran. The ticks of the hyperperiod are replayed from the next release
+ *             of every runnable , costs the ticks checked * the runnables in use (Not to be called every tick).
+ *             Event triggered & one shot runnables are not counted.
+ */
+enumError_t Sched_CheckSchedulability(Sched_Schedulability_t *Report);
+#endif
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+/*
+ * @brief    : Sets the handler of the runnables over their execution budget.
+ * @param[in]: Handler - Function choosing the action (NULL_PTR --> the overruns are only counted).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The handler runs in the SysTick interrupt , it must be short (e.g. log the index & return the action).
+ *             A runnable which never returns is not stopped by SCHED_BUDGET_SUSPEND , SCHED_WATCHDOG or
+ *             SCHED_BUDGET_RESET recovers it.
+ */
+enumError_t Sched_SetBudgetHandler(Sched_BudgetHandler_t Handler);
+
+/*
+ * @brief    : Gets the number of executions of a runnable which exceeded its budget.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Overruns - Pointer to store the number of executions over BudgetUs.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetBudgetOverruns(u32 RunnableIdx , u32 *Overruns);
+#endif
+
+#if SCHED_MODES == SCHED_ENABLE
+/*
+ * @brief    : Requests the switch to another operating mode.
+ * @param[in]: Mode - Index of the mode in SchedModeList (SchedModesList_t).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_MODES is enabled. Can be called from any runnable or ISR , the switch is applied
+ *             by the background loop before its next tick with the interrupts disabled so both levels switch at once
+ *             (The latest request wins). Runnables active in both modes keep their next release , the others
+ *             are removed or started with their DelayTimeMs + DelayTimeUs. The dynamic runnables are not affected.
+ */
+enumError_t Sched_SetMode(u32 Mode);
+
+/*
+ * @brief    : Gets the current operating mode.
+ * @param[out]: Mode - Pointer to store the index of the mode applied (Not the one requested yet).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetMode(u32 *Mode);
+#endif
 
 
 #endif /* SERVICE_SCHEDULER_H_ */
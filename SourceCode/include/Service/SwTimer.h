@@ -0,0 +1,128 @@
+/*
+ ============================================================================
+ Name        : SwTimer.h
+ Author      : Farah Mohey
+ Description : Header file for the software timers multiplexed on the SysTick
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef SERVICE_SWTIMER_H_
+#define SERVICE_SWTIMER_H_
+
+/******************************** Includes ************************************/
+#include "LIB/Std_Types.h"
+#include "LIB/Errors_enum.h"
+#include "CFG/SwTimer_Cfg.h"
+
+/*
+ * One-shot & periodic timers in milliseconds taken from a static pool of SWTIMER_MAX_TIMERS , all of them on the
+ * SysTick interrupt (Added by STK_AddCallBack next to the scheduler) & the timebase of STK_GetTimeMs.
+ * The running timers are kept in a list sorted by their expiry , so every tick only compares the nearest expiry
+ * with the time & the cost of a timer is paid when it is started or expires , not at every tick.
+ *
+ *   static void Uart_Timeout(u32 TimerId) { ... }
+ *
+ *   SwTimer_Create(20 , SWTIMER_ONE_SHOT , Uart_Timeout , &loc_TimerId);
+ *   SwTimer_Start(loc_TimerId);            --> Uart_Timeout(loc_TimerId) from the SysTick after 20 ms
+ *   SwTimer_Restart(loc_TimerId);          --> Every received byte pushes the timeout 20 ms later
+ */
+
+/***************************** Definitions *************************************/
+
+/* Modes of a timer */
+#define SWTIMER_ONE_SHOT		0	/* Stops after expiring once */
+#define SWTIMER_PERIODIC		1	/* Restarts at every expiry keeping its phase */
+
+/* Longest time of a timer , the expiries are compared with the wrapping millisecond time */
+#define SWTIMER_MAX_TIME_MS		0x3FFFFFFF
+
+/***************************** Types Declaration *******************************/
+
+/*Callback of a timer executed from the SysTick interrupt , takes the id of the expired timer
+ *so many timers can share one callback */
+typedef void (*SwTimer_CBF_t)(u32 TimerId);
+
+/************************** Functions Prototypes ******************************/
+
+/*
+ * @brief    : Initializes the software timers.
+ * @param[in]: None
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free callback of the SysTick).
+ * @details  : Frees all the timers & adds the handler of the timers to the SysTick interrupt.
+ *             The SysTick is configured & started by its owner (e.g. Sched_Init & Sched_Start).
+ */
+enumError_t SwTimer_Init(void);
+
+/*
+ * @brief    : Takes a timer from the pool.
+ * @param[in]: TimeMs - Time of the timer (1 to SWTIMER_MAX_TIME_MS).
+ * @param[in]: Mode - SWTIMER_ONE_SHOT or SWTIMER_PERIODIC.
+ * @param[in]: CallBack - Function called at every expiry.
+ * @param[out]: TimerId - Pointer to store the id of the timer in it.
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free timer in the pool).
+ * @details  : The timer is created stopped.
+ */
+enumError_t SwTimer_Create(u32 TimeMs , u8 Mode , SwTimer_CBF_t CallBack , u32 *TimerId);
+
+/*
+ * @brief    : Returns a timer to the pool.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : A running timer is stopped first , the id must not be used anymore.
+ */
+enumError_t SwTimer_Delete(u32 TimerId);
+
+/*
+ * @brief    : Starts a stopped timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : It expires after its time , never earlier (Up to 1 ms + one tick later).
+ *             A running timer keeps its expiry (SwTimer_Restart moves it).
+ */
+enumError_t SwTimer_Start(u32 TimerId);
+
+/*
+ * @brief    : Stops a timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Its callback is not called anymore , stopping a stopped timer has no effect.
+ */
+enumError_t SwTimer_Stop(u32 TimerId);
+
+/*
+ * @brief    : Starts a timer again from now whether it is running or stopped.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Used to push a timeout at every activity.
+ */
+enumError_t SwTimer_Restart(u32 TimerId);
+
+/*
+ * @brief    : Changes the time of a timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @param[in]: TimeMs - New time of the timer (1 to SWTIMER_MAX_TIME_MS).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Used from the next start or period , the current expiry of a running timer doesn't change.
+ */
+enumError_t SwTimer_SetTime(u32 TimerId , u32 TimeMs);
+
+/*
+ * @brief    : Gets whether a timer is running.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @param[out]: Running - Pointer to store 1 for a running timer , 0 for a stopped one.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t SwTimer_IsRunning(u32 TimerId , u8 *Running);
+
+/*
+ * @brief    : Gets the time till the nearest expiry of the running timers.
+ * @param[out]: TimeMs - Pointer to store the milliseconds till the nearest expiry in it (0 --> Already expired).
+ * @return   : enumError_t - Ok , Nok (No timer is running).
+ * @details  : Doesn't disable the interrupts , it is a snapshot unless called with them disabled
+ *             (The tickless idle of the scheduler limits its sleep by it).
+ */
+enumError_t SwTimer_GetTimeToExpiry(u32 *TimeMs);
+
+
+#endif /* SERVICE_SWTIMER_H_ */
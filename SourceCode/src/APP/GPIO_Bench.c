@@ -0,0 +1,189 @@
+/*
+ ============================================================================
+ Name        : GPIO_Bench.c
+ Author      : Farah Mohey
+ Description : Source file for GPIO_Bench ( To compare the cycles of the per-pin & port-wide GPIO APIs)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/****************************** Includes	***************************************/
+#include "APP/GPIO_Bench.h"
+#include "MCAL/GPIO.h"
+#include "MCAL/DWT.h"
+#include "LIB/CortexM4_Core.h"
+
+/****************************Definitions ***********************************/
+
+#define GPIO_BENCH_MAX_CYCLES		0xFFFFFFFF
+
+/*Which measurement of GPIO_Bench_Measure */
+#define GPIO_BENCH_EMPTY			0
+#define GPIO_BENCH_PIN_WRITE		1
+#define GPIO_BENCH_PORT_WRITE		2
+#define GPIO_BENCH_PIN_READ			3
+#define GPIO_BENCH_PORT_READ		4
+#define GPIO_BENCH_PIN_LOOP			5
+
+/************************* Static Functions Prototypes ********************************/
+static u32 GPIO_Bench_Measure(void *Port , u32 PinsMask , u32 Test);
+
+/************************* Implementation ***********************************/
+
+/*
+ * @brief    : Measures the cycles of updating & reading a group of pins with the per-pin & port-wide APIs.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: PinsMask - Pins of the benchmark , bit n for pin n (Already initialized as outputs).
+ * @param[out]: Result - Pointer to store the cycles of every API in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Uses the DWT cycle counter with the interrupts disabled (Started if needed , never cleared) , the pins
+ *             are toggled during the benchmark & left reset at its end. Read the result from the debugger (Or trace_printf).
+ */
+enumError_t GPIO_Bench_Run(void *Port , u32 PinsMask , GPIO_Bench_Result_t *Result)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Overhead = 0;
+	u32 loc_LoopOverhead = 0;
+	u32 loc_Mask = 0;
+
+	if(Result == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else if(PinsMask == 0)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		/*Validates the port & the mask with the API under test itself*/
+		Ret_ErrorStatus = GPIO_Set_PortMask(Port , 0 , PinsMask);
+	}
+
+	if(Ret_ErrorStatus == Ok)
+	{
+		/*DWT_Init would clear CYCCNT under the other users of the counter*/
+		Ret_ErrorStatus = DWT_Start();
+	}
+
+	if(Ret_ErrorStatus == Ok)
+	{
+		Result->PinsNumber = 0;
+		for(loc_Mask = PinsMask ; loc_Mask != 0 ; loc_Mask &= (loc_Mask - 1))
+		{
+			Result->PinsNumber++;
+		}
+
+		/*Cost of reading CYCCNT twice , removed from every measurement*/
+		loc_Overhead = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_EMPTY);
+
+		/*Cost of the loop over the pins without any call , removed from the per-pin APIs*/
+		Result->PinLoopCycles = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_PIN_LOOP) - loc_Overhead;
+		loc_LoopOverhead = loc_Overhead + Result->PinLoopCycles;
+
+		Result->PinApiWriteCycles  = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_PIN_WRITE) - loc_LoopOverhead;
+		Result->PortApiWriteCycles = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_PORT_WRITE) - loc_Overhead;
+		Result->PinApiReadCycles   = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_PIN_READ) - loc_LoopOverhead;
+		Result->PortApiReadCycles  = GPIO_Bench_Measure(Port , PinsMask , GPIO_BENCH_PORT_READ) - loc_Overhead;
+
+		/*Rounded to the nearest cycle*/
+		Result->PinApiWriteCyclesPerPin  = (Result->PinApiWriteCycles  + (Result->PinsNumber / 2)) / Result->PinsNumber;
+		Result->PortApiWriteCyclesPerPin = (Result->PortApiWriteCycles + (Result->PinsNumber / 2)) / Result->PinsNumber;
+		Result->PinApiReadCyclesPerPin   = (Result->PinApiReadCycles   + (Result->PinsNumber / 2)) / Result->PinsNumber;
+		Result->PortApiReadCyclesPerPin  = (Result->PortApiReadCycles  + (Result->PinsNumber / 2)) / Result->PinsNumber;
+
+		GPIO_Set_PortMask(Port , 0 , PinsMask);
+	}
+
+	return Ret_ErrorStatus;
+}
+
+/*
+ * @brief    : Measures one test GPIO_BENCH_REPEATS times.
+ * @param[in]: Port - Pointer to the GPIO port.
+ * @param[in]: PinsMask - Pins of the benchmark.
+ * @param[in]: Test - GPIO_BENCH_EMPTY , GPIO_BENCH_PIN_LOOP , GPIO_BENCH_PIN_WRITE , ...
+ * @return   : u32 - The minimum cycles of the repeats including the reading of CYCCNT.
+ * @details  : The writes alternate between setting & resetting the pins so every repeat changes them.
+ */
+static u32 GPIO_Bench_Measure(void *Port , u32 PinsMask , u32 Test)
+{
+	u32 loc_MinCycles = GPIO_BENCH_MAX_CYCLES;
+	u32 loc_Repeat = 0;
+	u32 loc_Pin = 0;
+	u32 loc_Start = 0;
+	u32 loc_Cycles = 0;
+	u32 loc_Value = 0;
+	u32 loc_PinState = 0;
+
+	for(loc_Repeat = 0 ; loc_Repeat < GPIO_BENCH_REPEATS ; loc_Repeat++)
+	{
+		loc_PinState = (loc_Repeat & 1) ? GPIO_RESET_PIN : GPIO_SET_PIN;
+
+		Core_DisableIRQ();
+		loc_Start = DWT_GetCycleCount();
+
+		switch(Test)
+		{
+			case GPIO_BENCH_PIN_WRITE:
+				for(loc_Pin = GPIO_PIN0 ; loc_Pin <= GPIO_PIN15 ; loc_Pin++)
+				{
+					if(PinsMask & GPIO_PIN_MASK(loc_Pin))
+					{
+						GPIO_Set_PinValue(Port , loc_Pin , loc_PinState);
+					}
+				}
+				break;
+
+			case GPIO_BENCH_PORT_WRITE:
+				if(loc_PinState == GPIO_SET_PIN)
+				{
+					GPIO_Set_PortMask(Port , PinsMask , 0);
+				}
+				else
+				{
+					GPIO_Set_PortMask(Port , 0 , PinsMask);
+				}
+				break;
+
+			case GPIO_BENCH_PIN_READ:
+				for(loc_Pin = GPIO_PIN0 ; loc_Pin <= GPIO_PIN15 ; loc_Pin++)
+				{
+					if(PinsMask & GPIO_PIN_MASK(loc_Pin))
+					{
+						GPIO_Get_PinValue(Port , loc_Pin , &loc_Value);
+					}
+				}
+				break;
+
+			case GPIO_BENCH_PORT_READ:
+				GPIO_Get_PortValue(Port , &loc_Value);
+				break;
+
+			case GPIO_BENCH_PIN_LOOP:
+				/*Same loop as the per-pin APIs , the nop keeps the compiler from removing it*/
+				for(loc_Pin = GPIO_PIN0 ; loc_Pin <= GPIO_PIN15 ; loc_Pin++)
+				{
+					if(PinsMask & GPIO_PIN_MASK(loc_Pin))
+					{
+						Core_Idle();
+					}
+				}
+				break;
+
+			default:
+				/*GPIO_BENCH_EMPTY --> Only the reading of CYCCNT*/
+				break;
+		}
+
+		loc_Cycles = DWT_GetCycleCount() - loc_Start;
+		Core_EnableIRQ();
+
+		if(loc_Cycles < loc_MinCycles)
+		{
+			loc_MinCycles = loc_Cycles;
+		}
+	}
+
+	return loc_MinCycles;
+}
@@ -0,0 +1,82 @@
+/*
+ ============================================================================
+ Name        : GPIO_Image_Cfg.c
+ Author      : Farah Mohey
+ Description : Source file of the register images of the GPIO ports
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes	*************************************/
+
+#include "MCAL/GPIO.h"
+#include "CFG/GPIO_Image_Cfg.h"
+#include "CFG/LED_Cfg.h"
+#include "CFG/SWITCH_Cfg.h"
+
+/******************************** Definitions *********************************/
+
+/*Fields of the Mood of MCAL/GPIO.h (Same masks as src/MCAL/GPIO.c) */
+#define GPIO_IMAGE_MODE_MASK		0x03
+#define GPIO_IMAGE_OUT_TYPE_MASK	0x04
+#define GPIO_IMAGE_OUT_TYPE_SHIFT	2
+#define GPIO_IMAGE_PULL_MASK		0x18
+#define GPIO_IMAGE_PULL_SHIFT		3
+#define GPIO_IMAGE_MODE_AF			0x02
+
+/*Field of Width bits of a pin in a register of an image*/
+#define GPIO_IMAGE_FIELD(Register , Position , Width)	( ((Register) >> (Position)) & ((1UL << (Width)) - 1) )
+
+/*Row of GPIO_IMAGE_TABLE from the registers of a port in CFG/GPIO_Image_Cfg.h*/
+#define GPIO_IMAGE_ROW(Index)	{ GPIO_IMAGE_PORT##Index , GPIO_IMAGE_PORT##Index##_MODER , GPIO_IMAGE_PORT##Index##_OTYPER ,		\
+		GPIO_IMAGE_PORT##Index##_OSPEEDR , GPIO_IMAGE_PORT##Index##_PUPDR , GPIO_IMAGE_PORT##Index##_AFRL ,					\
+		GPIO_IMAGE_PORT##Index##_AFRH , GPIO_IMAGE_PORT##Index##_BSRR }
+
+/*Every pin of GPIO_IMAGE_PINS is valid & has its mood , speed , alternate function & level in the images of its port*/
+#define GPIO_IMAGE_CHECK_PIN(Arg , Port , Pin , Mood , Speed , AltFunc , Level)												\
+	_Static_assert( ((Pin) <= GPIO_PIN15) && ((Mood) <= GPIO_AF_OD_PD) && ((Speed) <= GPIO_VERY_HIGH_SPEED) &&			\
+			((AltFunc) <= GPIO_AF15) && ((Level) <= 1) , "GPIO image : wrong pin , mood , speed , AltFunc or level");	\
+	_Static_assert( (GPIO_IMAGE_FIELD(GPIO_IMAGE_PORT##Port##_MODER , (Pin) * 2 , 2) == ((Mood) & GPIO_IMAGE_MODE_MASK)) &&	\
+			(GPIO_IMAGE_FIELD(GPIO_IMAGE_PORT##Port##_OTYPER , (Pin) , 1) ==											\
+					(((Mood) & GPIO_IMAGE_OUT_TYPE_MASK) >> GPIO_IMAGE_OUT_TYPE_SHIFT)) &&								\
+			(GPIO_IMAGE_FIELD(GPIO_IMAGE_PORT##Port##_PUPDR , (Pin) * 2 , 2) ==											\
+					(((Mood) & GPIO_IMAGE_PULL_MASK) >> GPIO_IMAGE_PULL_SHIFT)) ,										\
+			"GPIO image : MODER , OTYPER or PUPDR doesn't match the mood of a pin");									\
+	_Static_assert( GPIO_IMAGE_FIELD(GPIO_IMAGE_PORT##Port##_OSPEEDR , (Pin) * 2 , 2) == (Speed) ,							\
+			"GPIO image : OSPEEDR doesn't match the speed of a pin");													\
+	_Static_assert( GPIO_IMAGE_FIELD( ((Pin) < 8) ? GPIO_IMAGE_PORT##Port##_AFRL : GPIO_IMAGE_PORT##Port##_AFRH ,		\
+			((Pin) % 8) * 4 , 4) == ((((Mood) & GPIO_IMAGE_MODE_MASK) == GPIO_IMAGE_MODE_AF) ? (AltFunc) : GPIO_AF0) ,		\
+			"GPIO image : AFRL or AFRH doesn't match the alternate function of a pin");									\
+	_Static_assert( GPIO_IMAGE_FIELD(GPIO_IMAGE_PORT##Port##_BSRR , (Pin) , 1) == (Level) ,								\
+			"GPIO image : BSRR doesn't match the initial level of a pin");
+
+/*A pin used twice is counted twice in the sum of the pins of its port but once in their OR*/
+#define GPIO_IMAGE_PIN_SUM(Arg , Port , Pin , Mood , Speed , AltFunc , Level)	+ ( ((Port) == (Arg)) ? (1UL << (Pin)) : 0 )
+#define GPIO_IMAGE_PIN_OR(Arg , Port , Pin , Mood , Speed , AltFunc , Level)	| ( ((Port) == (Arg)) ? (1UL << (Pin)) : 0 )
+#define GPIO_IMAGE_CHECK_CONFLICTS(Port)	_Static_assert( (0 GPIO_IMAGE_PINS(GPIO_IMAGE_PIN_SUM , Port)) ==				\
+		(0 GPIO_IMAGE_PINS(GPIO_IMAGE_PIN_OR , Port)) , "GPIO image : a pin is used twice")
+
+/***************************** Implementation ********************************/
+
+/*The images are generated from LEDS[] & SWITCHES[] by tools/GPIO_Image.py , the compiler can't read the tables
+ *so it checks the counts of the tables & the images against the pins they were generated from (A wrong or edited
+ *header doesn't compile) , tools/GPIO_Image.py --check finds a table changed without regenerating the header
+ *(Pre-build step of the target project) */
+_Static_assert(GPIO_IMAGE_LEDS == _Led_Num , "LEDS[] changed , regenerate CFG/GPIO_Image_Cfg.h by tools/GPIO_Image.py");
+_Static_assert(GPIO_IMAGE_SWITCHES == _Switch_Num , "SWITCHES[] changed , regenerate CFG/GPIO_Image_Cfg.h by tools/GPIO_Image.py");
+
+GPIO_IMAGE_PINS(GPIO_IMAGE_CHECK_PIN , 0)
+
+/*Every port of the STM32F401 (GPIO_PORTA B C D E H) can have an image*/
+GPIO_IMAGE_CHECK_CONFLICTS(0);
+GPIO_IMAGE_CHECK_CONFLICTS(1);
+GPIO_IMAGE_CHECK_CONFLICTS(2);
+GPIO_IMAGE_CHECK_CONFLICTS(3);
+GPIO_IMAGE_CHECK_CONFLICTS(4);
+GPIO_IMAGE_CHECK_CONFLICTS(5);
+
+/*Global array of the images of the ports , given to GPIO_InitImages at boot */
+const GPIO_Image_t GPIO_Images[GPIO_IMAGE_PORTS] =
+{
+	GPIO_IMAGE_TABLE
+};
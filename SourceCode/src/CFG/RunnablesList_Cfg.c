@@ -37,3 +37,38 @@ const  Runnable_t RunnableList[_MaxRunnables] =
     //[LCD] = {.Name = "LCD", .PeriodicityMs = 2,  .cb = LCD_Runnable , .DelayTime = 0},
   //  [LCDTest]={.Name = "LCDTest", .PeriodicityMs = 1000,  .cb =LCDTest_Runnable , .DelayTime = 20}
 };
+
+#if SCHED_MODES == SCHED_ENABLE
+/*Tables of the other modes , indexed by RunnablesList_t like RunnableList
+ *A runnable left out (No callback) is inactive in the mode */
+/*Ex :
+const  Runnable_t NormalModeList[_MaxRunnables] =
+{
+    [SWITCH] = {.Name = "SwitchRunnable", .PeriodicityMs = 5,  .cb = HSwitch_Runnable , .DelayTimeMs = 0},
+    [Traffic] = {.Name = "TrafficLight", .PeriodicityMs = 2000,  .cb = Traffic_Runnable , .DelayTimeMs = 0},
+    [LCD] = {.Name = "LCD", .PeriodicityMs = 2,  .cb = LCD_Runnable , .DelayTimeMs = 0},
+};
+
+const  Runnable_t DegradedModeList[_MaxRunnables] =
+{
+    [SWITCH] = {.Name = "SwitchRunnable", .PeriodicityMs = 5,  .cb = HSwitch_Runnable , .DelayTimeMs = 0},
+    [LCD] = {.Name = "LCD", .PeriodicityMs = 20,  .cb = LCD_Runnable , .DelayTimeMs = 0},
+};
+
+const  Runnable_t LowPowerModeList[_MaxRunnables] =
+{
+    [SWITCH] = {.Name = "SwitchRunnable", .PeriodicityMs = 50,  .cb = HSwitch_Runnable , .DelayTimeMs = 0},
+};
+*/
+
+/*Table of every mode of SchedModesList_t , the first one is started by Sched_Init */
+const Runnable_t *const SchedModeList[_MaxSchedModes] =
+{
+   /*Ex :
+    [MODE_STARTUP] = RunnableList,
+    [MODE_NORMAL] = NormalModeList,
+    [MODE_DEGRADED] = DegradedModeList,
+    [MODE_LOW_POWER] = LowPowerModeList,
+   */
+};
+#endif
@@ -0,0 +1,23 @@
+/*
+ ============================================================================
+ Name        : RunnablesOffsets_Cfg.c
+ Author      : Farah Mohey
+ Description : Source File of the optimized first release of the Scheduler runnables
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/* Generated by tools/Sched_Offsets.py , don't edit it manually */
+
+/******************************* Includes **************************************/
+
+#include "CFG/RunnablesList_Cfg.h"
+#include "Service/Scheduler.h"
+
+/***************************** Implementation **********************************/
+
+/*First release of every runnable in microseconds , used instead of DelayTimeMs + DelayTimeUs when SCHED_OPTIMIZED_OFFSETS is enabled */
+const u32 RunnableOffsetsUs[_MaxRunnables] =
+{
+
+};
@@ -25,21 +25,27 @@ enumError_t LED_Init (void)
 	/*Variable to store error status to be returned at the end of the function */
 	u32 Ret_ErrorStatus = Ok;
 
-	/*Create an object from  GPIO_Config_t struct to configure the provided leds*/
-	GPIO_Config_t led;
-	led.Mood= GPIO_OUTPUT_PP;		/*Configure all LEDs Mood as Push PUll */
-	led.Speed=GPIO_HIGH_SPEED;
+	/*Create an array of GPIO_Config_t to configure all the provided leds at once*/
+	GPIO_Config_t leds[_Led_Num];
 
-	/*Loop for each led to initialize it */
+	/*Loop for each led to fill its configuration */
 	u8 loc_idx=0;
 	for (loc_idx=0 ; loc_idx < _Led_Num; loc_idx++)
 	{
 		/*configure leds' port and pin in GPIO*/
-		led.Port = LEDS[loc_idx].Port;
-		led.Pin = LEDS[loc_idx].Pin;
+		leds[loc_idx].Port = LEDS[loc_idx].Port;
+		leds[loc_idx].Pin = LEDS[loc_idx].Pin;
+		leds[loc_idx].Mood= GPIO_OUTPUT_PP;		/*Configure all LEDs Mood as Push PUll */
+		leds[loc_idx].Speed=GPIO_HIGH_SPEED;
+		leds[loc_idx].AltFunc=GPIO_AF0;		/*Not used by the outputs*/
+	}
+
+	/*Init GPIO pins , every register of a port is written once for all its leds */
+	Ret_ErrorStatus = GPIO_InitPins(leds , _Led_Num);
 
-		/*Init GPIO pins And Set the init status for the required LED */
-		Ret_ErrorStatus = GPIO_InitPin(&led);
+	/*Set the init status for the required LEDs */
+	for (loc_idx=0 ; (loc_idx < _Led_Num) && (Ret_ErrorStatus == Ok) ; loc_idx++)
+	{
 		Ret_ErrorStatus = GPIO_Set_PinValue( LEDS[loc_idx].Port , LEDS[loc_idx].Pin , ( (LEDS[loc_idx].Connection) ^ (LEDS[loc_idx].Status) ) );
 	}
 
@@ -60,16 +66,15 @@ enumError_t LED_Set_Status(u32 LEDName , u32 LEDStatus)
 	u32 Ret_ErrorStatus = Nok;
 
 	/*Validate if user entered valid input , Valid LEDName & Valid LEDStatus */
-	if( (LEDName > _Led_Num ) || ( (LEDStatus != LED_ON) && (LEDStatus != LED_OFF) ) )
+	if( (LEDName >= _Led_Num ) || ( (LEDStatus != LED_ON) && (LEDStatus != LED_OFF) ) )
 	{
 		Ret_ErrorStatus= WrongInput ;
 	}
 
 	else
-	{    /*Set the required pin with the required status whether it was on or off */
-		GPIO_Set_PinValue( LEDS[LEDName].Port , LEDS[LEDName].Pin , ( (LEDS[LEDName].Connection) ^ LEDStatus ) );
-
-		Ret_ErrorStatus = Ok;
+	{    /*Set the required pin with the required status whether it was on or off ,
+		  *LEDS[] is read at runtime so the validated GPIO_Set_PinValue is used (Not the unchecked fast path) */
+		Ret_ErrorStatus = GPIO_Set_PinValue( LEDS[LEDName].Port , LEDS[LEDName].Pin , ( (LEDS[LEDName].Connection) ^ LEDStatus ) );
 
 		/* Toggle the LEDStatus with the LED Connection, So The value refers to the pin status
 		 *
@@ -31,22 +31,24 @@ enumError_t SWITCH_Init (void)
 	/*Variable to store error status to be returned at the end of the function */
 	u32 Ret_ErrorStatus = Ok;
 
-	/*Create an object from  GPIO_Config_t struct to configure the provided switches*/
-	GPIO_Config_t Switch;
+	/*Create an array of GPIO_Config_t to configure all the provided switches at once*/
+	GPIO_Config_t Switches[_Switch_Num];
 
-	/*Loop for each led to initialize it */
+	/*Loop for each switch to fill its configuration */
 	u8 loc_idx=0;
 	for (loc_idx=0 ; loc_idx < _Switch_Num; loc_idx++)
 	{
 		/*configure Switch' port, pin, mood in GPIO*/
-		Switch.Port = SWITCHES[loc_idx].Port;
-		Switch.Pin = SWITCHES[loc_idx].Pin;
-	Switch.Mood = SWITCHES[loc_idx].Connection;
-
-		/*Init GPIO pins And Set the init status for the required switch */
-		Ret_ErrorStatus = GPIO_InitPin(&Switch);
+		Switches[loc_idx].Port = SWITCHES[loc_idx].Port;
+		Switches[loc_idx].Pin = SWITCHES[loc_idx].Pin;
+		Switches[loc_idx].Mood = SWITCHES[loc_idx].Connection;
+		Switches[loc_idx].Speed = GPIO_LOW_SPEED;		/*Not used by the inputs*/
+		Switches[loc_idx].AltFunc = GPIO_AF0;			/*Not used by the inputs*/
 	}
 
+	/*Init GPIO pins , every register of a port is written once for all its switches */
+	Ret_ErrorStatus = GPIO_InitPins(Switches , _Switch_Num);
+
 	/*Return the error status*/
 	return Ret_ErrorStatus ;
 
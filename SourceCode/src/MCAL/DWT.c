@@ -0,0 +1,83 @@
+/*
+ ============================================================================
+ Name        : DWT.c
+ Author      : Farah Mohey
+ Description : Source file for DWT (Data watchpoint and trace unit of Cortex-M4) cycle counter
+ Created	 : 22-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "MCAL/DWT.h"
+
+/***************************** Definitions *************************************/
+#define DWT_BASE_ADDRESS        0xE0001000
+#define DEMCR_ADDRESS           0xE000EDFC		/*Debug exception and monitor control register */
+
+#define DEMCR_TRCENA_MASK       BIT24_MASK		/*Bit24 = 1 --> Enables the DWT unit */
+#define DWT_CYCCNTENA_MASK      BIT0_MASK		/*Bit0 = 1 --> Enables CYCCNT */
+
+/**************************** Types Declaration ********************************/
+typedef struct
+{
+	u32 DWT_CTRL;
+	u32 DWT_CYCCNT;
+} DWT_PERI_t;
+
+
+/****************************** Variables **************************************/
+
+/* Pointer to the DWT peripheral structure */
+static volatile DWT_PERI_t *const DWT = (volatile DWT_PERI_t *) DWT_BASE_ADDRESS;
+
+/* Pointer to the debug exception and monitor control register */
+static volatile u32 *const DEMCR = (volatile u32 *) DEMCR_ADDRESS;
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Enables the cycle counter of the DWT.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Enables the trace unit (TRCENA) , clears CYCCNT & starts counting the processor clock cycles.
+ */
+enumError_t DWT_Init(void)
+{
+	/* The DWT registers are accessible only after enabling the trace unit */
+	*DEMCR |= DEMCR_TRCENA_MASK;
+
+	DWT->DWT_CYCCNT = 0;
+	DWT->DWT_CTRL |= DWT_CYCCNTENA_MASK;
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Starts the cycle counter of the DWT if it isn't already counting.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Never clears CYCCNT , so the timestamps taken by the other users of the counter (Scheduler profiling ,
+ * 				the debugger) stay valid.
+ */
+enumError_t DWT_Start(void)
+{
+	/* Setting the enable bits again doesn't disturb a running counter */
+	*DEMCR |= DEMCR_TRCENA_MASK;
+	DWT->DWT_CTRL |= DWT_CYCCNTENA_MASK;
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Gets the current value of the cycle counter (CYCCNT).
+ * @param   : None
+ * @return  : u32 - Processor clock cycles counted since DWT_Init , wraps around every 2 pwr 32 cycles.
+ * @details : Returns the value directly without validation to keep it usable to timestamp hot paths.
+ */
+u32 DWT_GetCycleCount(void)
+{
+	return DWT->DWT_CYCCNT;
+}
@@ -8,6 +8,7 @@
  */
 
 /****************************** Includes	***************************************/
+#include <stddef.h>
 #include "MCAL/GPIO.h"
 
 /****************************Definitions ***********************************/
@@ -20,6 +21,7 @@
 #define GPIO_SET_1_BIT      BIT0_MASK	/*0x00000001*/
 #define GPIO_SET_2_BITS     0x00000003
 #define GPIO_SET_3_BITS     0x00000007
+#define GPIO_SET_4_BITS     0x0000000F
 
 
 #define GPIO_OUT_TYPE_SHIFT         2
@@ -27,6 +29,15 @@
 
 #define GPIO_GROUP_OF_2_BITS        2
 #define GPIO_GROUP_OF_3_BITS        3
+#define GPIO_GROUP_OF_4_BITS        4
+
+#define GPIO_MODE_AF                2	/*Mode of the GPIO_AF_* moods*/
+#define GPIO_AFR_PINS               8	/*Pins of AFRL (0 --> 7) & AFRH (8 --> 15)*/
+
+/*Index of a port in the tables of GPIO_InitPins , ports are 0x400 apart (A-->0 ... E-->4 , H-->7) */
+#define GPIO_PORT_INDEX(Port)	( (u32)( (u8 *)(Port) - (u8 *)GPIO_PORTA ) / GPIO_PORT_SPAN )
+#define GPIO_PORT_SPAN			0x400
+#define GPIO_PORTS_INDEXES		8
 
 
 /************************* Types Declaration ********************************/
@@ -44,6 +55,31 @@ typedef struct
 	u32 AFRH      ;
 }GPIO_PORT_t;
 
+/*Fields of one or more pins of a port , positioned in the registers (Built in local variables then written once) */
+typedef struct
+{
+	u32 Mask_2Bits;		/*Bits of the pins in MODER , OSPEEDR , PUPDR*/
+	u32 Mask_1Bit;		/*Bits of the pins in OTYPER*/
+	u32 Mask_AFRL;		/*Bits of the pins 0 --> 7 in AFRL*/
+	u32 Mask_AFRH;		/*Bits of the pins 8 --> 15 in AFRH*/
+	u32 MODER;
+	u32 OTYPER;
+	u32 OSPEEDR;
+	u32 PUPDR;
+	u32 AFRL;
+	u32 AFRH;
+}GPIO_PortImage_t;
+
+
+/*The inline fast path of GPIO.h accesses the registers by their indexes*/
+_Static_assert(offsetof(GPIO_PORT_t , IDR) == GPIO_IDR_INDEX * sizeof(u32) , "GPIO_IDR_INDEX doesn't match GPIO_PORT_t");
+_Static_assert(offsetof(GPIO_PORT_t , BSRR) == GPIO_BSRR_INDEX * sizeof(u32) , "GPIO_BSRR_INDEX doesn't match GPIO_PORT_t");
+
+
+/************************* Static Functions Prototypes ********************************/
+static enumError_t GPIO_CheckConfig(const GPIO_Config_t *Loc_GPIOElement);
+static void GPIO_AddPinImage(const GPIO_Config_t *Loc_GPIOElement , GPIO_PortImage_t *Image);
+static void GPIO_WritePortImage(void *Port , const GPIO_PortImage_t *Image);
 
 /***************************** Implementation  ********************************/
 
@@ -56,76 +92,129 @@ typedef struct
 enumError_t GPIO_InitPin (GPIO_Config_t *Loc_GPIOElement)
 {
 	u32 Ret_ErrorStatus = Nok;
+	GPIO_PortImage_t loc_Image = {0};
 
 	/*Validate the input parameters*/
-	if(Loc_GPIOElement == NULL_PTR)
-	{
-		Ret_ErrorStatus= NullPointer;
-	}
+	Ret_ErrorStatus = GPIO_CheckConfig(Loc_GPIOElement);
 
-	else if(Loc_GPIOElement->Mood >GPIO_AF_OD_PD || Loc_GPIOElement->Speed >GPIO_VERY_HIGH_SPEED)
+	if(Ret_ErrorStatus == Ok)
 	{
-		Ret_ErrorStatus= WrongInput;
+		GPIO_AddPinImage(Loc_GPIOElement , &loc_Image);
+		GPIO_WritePortImage(Loc_GPIOElement->Port , &loc_Image);
 	}
 
-	else if ( (Loc_GPIOElement->Port < GPIO_PORTA || Loc_GPIOElement->Port > GPIO_PORTE ) && Loc_GPIOElement->Port != GPIO_PORTH )
-	{
-		Ret_ErrorStatus= WrongInput;
-	}
+	return Ret_ErrorStatus;
+}
 
-	else if(Loc_GPIOElement->Pin > GPIO_PIN15)
+/*
+ * @brief    : Initializes a group of GPIO pins writing every register of a port once.
+ * @param[in]: Configs - Array of the configurations of the pins (Any order , any ports).
+ * @param[in]: Count - Number of configurations in the array.
+ * @return   : enumError_t - Error status indicating success or failure of the initialization.
+ * @details  : All the configurations are validated before writing any register , so on an error no pin is changed.
+ *             The fields of the pins are gathered per port in local variables then MODER , OTYPER , OSPEEDR ,
+ *             PUPDR , AFRL & AFRH of every used port are read-modified-written once instead of once per pin.
+ *             A pin repeated in the array takes its last configuration like successive GPIO_InitPin.
+ */
+enumError_t GPIO_InitPins (const GPIO_Config_t *Configs , u32 Count)
+{
+	u32 Ret_ErrorStatus = Nok;
+	GPIO_PortImage_t loc_Images[GPIO_PORTS_INDEXES] = {0};
+	void *loc_Ports[GPIO_PORTS_INDEXES] = {NULL_PTR};
+	u32 loc_Idx = 0;
+	u32 loc_PortIdx = 0;
+
+	if(Configs == NULL_PTR)
 	{
-		Ret_ErrorStatus= WrongInput;
+		Ret_ErrorStatus= NullPointer;
 	}
 	else
 	{
 		Ret_ErrorStatus = Ok;
 
-		/* Getting the Mode value , Output Type , the value of pull-up/pull-down from the mask
-		 * By Anding with the Clear Mask And Shifting with this bits.
-		 * The first 2 bits --> Mode
-		 * The second 1 bit --> Output Type
-		 * The Third 2 bits --> PullUp Or PullDown
-		 */
-		u32 Loc_Mode_Value = (Loc_GPIOElement->Mood) & GPIO_MODE_MASK;
-		u32 Loc_OutType_Value = ( (Loc_GPIOElement->Mood) & GPIO_OUT_TYPE_MASK ) >> GPIO_OUT_TYPE_SHIFT ;
-		u32 Loc_Pull_Value = (Loc_GPIOElement->Mood) & GPIO_PULL_TYPE_MASK >> GPIO_PULL_TYPE_SHIFT;
-
-
-		/*Assign the addresses in local vars */
-		u32 loc_MODER_Temp	=((GPIO_PORT_t *)Loc_GPIOElement->Port)-> MODER ;
-		u32 loc_OTYPER_Temp	=((GPIO_PORT_t *)Loc_GPIOElement->Port )->OTYPER;
-		u32 loc_OSPEEDR_Temp=((GPIO_PORT_t *)Loc_GPIOElement->Port)->OSPEEDR ;
-		u32 loc_PUPDR_Temp	=((GPIO_PORT_t *)Loc_GPIOElement->Port)->PUPDR ;
-
+		/*Validate all the configurations first*/
+		for(loc_Idx = 0 ; (loc_Idx < Count) && (Ret_ErrorStatus == Ok) ; loc_Idx++)
+		{
+			Ret_ErrorStatus = GPIO_CheckConfig(&Configs[loc_Idx]);
+		}
+	}
 
-		/*Clear bits which will be configured according to the provided configuration from the user*/
+	if(Ret_ErrorStatus == Ok)
+	{
+		/*Gather the pins per port*/
+		for(loc_Idx = 0 ; loc_Idx < Count ; loc_Idx++)
+		{
+			loc_PortIdx = GPIO_PORT_INDEX(Configs[loc_Idx].Port);
+			loc_Ports[loc_PortIdx] = Configs[loc_Idx].Port;
+			GPIO_AddPinImage(&Configs[loc_Idx] , &loc_Images[loc_PortIdx]);
+		}
+
+		/*Write every used port once*/
+		for(loc_PortIdx = 0 ; loc_PortIdx < GPIO_PORTS_INDEXES ; loc_PortIdx++)
+		{
+			if(loc_Ports[loc_PortIdx] != NULL_PTR)
+			{
+				GPIO_WritePortImage(loc_Ports[loc_PortIdx] , &loc_Images[loc_PortIdx]);
+			}
+		}
+	}
 
-		/*Each Pin is represented by 2 bits , so we need to shift according to the pin number after multiplying it by 2 */
-		loc_MODER_Temp   &= ~ (GPIO_SET_2_BITS << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) );
-		loc_OSPEEDR_Temp &= ~ (GPIO_SET_2_BITS << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) );
-		loc_PUPDR_Temp	 &= ~ (GPIO_SET_2_BITS << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) );
-		loc_OTYPER_Temp  &= ~ (GPIO_SET_1_BIT) << (Loc_GPIOElement->Pin); /*OTYPER is represented by 1 bit only */
+	return Ret_ErrorStatus;
+}
 
+/*
+ * @brief    : Initializes whole ports from their register images precomputed at build time.
+ * @param[in]: Images - Array of the images of the ports (e.g. GPIO_Images).
+ * @param[in]: Count - Number of images in the array (e.g. GPIO_IMAGE_PORTS).
+ * @return   : enumError_t - Error status indicating success or failure of the initialization.
+ * @details  : Every register of a port is stored once without reading it , the pins out of the tables of the
+ *             generator take their reset configuration , so it is called at boot before any other GPIO setting.
+ *             The output levels are stored first & MODER last so the outputs start driving their initial level.
+ *             All the ports are validated before writing any register.
+ */
+enumError_t GPIO_InitImages (const GPIO_Image_t *Images , u32 Count)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Idx = 0;
+	volatile GPIO_PORT_t *loc_Port = NULL_PTR;
 
-		/*Set bits which will be configured according to the provided configuration from the user in the temp vars */
-		loc_MODER_Temp   |=  (Loc_Mode_Value << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) );
-		loc_PUPDR_Temp	 |=  (Loc_Pull_Value << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) );
-		loc_OTYPER_Temp  |=  Loc_OutType_Value << (Loc_GPIOElement->Pin); /*OTYPER is represented by 1 bit only */
-		loc_OSPEEDR_Temp |=  (Loc_GPIOElement->Speed << ( (Loc_GPIOElement ->Pin) * GPIO_GROUP_OF_2_BITS) ); /*Speed is not injected in the Mood */
+	if(Images == NULL_PTR)
+	{
+		Ret_ErrorStatus= NullPointer;
+	}
+	else
+	{
+		Ret_ErrorStatus = Ok;
 
+		/*Validate all the ports first*/
+		for(loc_Idx = 0 ; (loc_Idx < Count) && (Ret_ErrorStatus == Ok) ; loc_Idx++)
+		{
+			if( !GPIO_IS_VALID_PORT(Images[loc_Idx].Port) )
+			{
+				Ret_ErrorStatus= WrongInput;
+			}
+		}
+	}
 
-		/*ReAllocate the new configuration of temp back to the registers to init the pin with the new configuration*/
-		((GPIO_PORT_t *)Loc_GPIOElement->Port)-> MODER   = loc_MODER_Temp;
-		((GPIO_PORT_t *)Loc_GPIOElement->Port)-> OTYPER  = loc_OTYPER_Temp;
-		((GPIO_PORT_t *)Loc_GPIOElement->Port)-> OSPEEDR = loc_OSPEEDR_Temp;
-		((GPIO_PORT_t *)Loc_GPIOElement->Port)-> PUPDR   = loc_PUPDR_Temp;
+	if(Ret_ErrorStatus == Ok)
+	{
+		for(loc_Idx = 0 ; loc_Idx < Count ; loc_Idx++)
+		{
+			loc_Port = (volatile GPIO_PORT_t *)Images[loc_Idx].Port;
+
+			loc_Port->BSRR    = Images[loc_Idx].BSRR;
+			loc_Port->OTYPER  = Images[loc_Idx].OTYPER;
+			loc_Port->OSPEEDR = Images[loc_Idx].OSPEEDR;
+			loc_Port->PUPDR   = Images[loc_Idx].PUPDR;
+			loc_Port->AFRL    = Images[loc_Idx].AFRL;
+			loc_Port->AFRH    = Images[loc_Idx].AFRH;
+			loc_Port->MODER   = Images[loc_Idx].MODER;
+		}
 	}
 
 	return Ret_ErrorStatus;
 }
 
-
 /*
  * @brief    : Sets the value of a GPIO pin to a specified state.
  * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
@@ -145,7 +234,7 @@ enumError_t GPIO_Set_PinValue(void *Port , u32 PinNum , u32 PinState )
 		Ret_ErrorStatus= NullPointer;
 	}
 
-	else if ( (Port < GPIO_PORTA || Port > GPIO_PORTE ) && Port != GPIO_PORTH )
+	else if ( !GPIO_IS_VALID_PORT(Port) )
 	{
 		Ret_ErrorStatus= WrongInput;
 	}
@@ -188,7 +277,7 @@ enumError_t GPIO_Get_PinValue(void *Port , u32 PinNum,  u32 *PinStatus)
 		Ret_ErrorStatus= NullPointer;
 	}
 
-	else if ( (Port < GPIO_PORTA || Port > GPIO_PORTE ) && Port != GPIO_PORTH )
+	else if ( !GPIO_IS_VALID_PORT(Port) )
 	{
 		Ret_ErrorStatus= WrongInput;
 	}
@@ -208,3 +297,203 @@ enumError_t GPIO_Get_PinValue(void *Port , u32 PinNum,  u32 *PinStatus)
 }
 
 
+
+/*
+ * @brief    : Sets & resets any group of pins of a port together.
+ * @param[in]: Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[in]: SetMask - Pins to be set , bit n for pin n (GPIO_PIN_MASK(GPIO_PINx) | ... , up to GPIO_ALL_PINS_MASK).
+ * @param[in]: ResetMask - Pins to be reset , bit n for pin n (up to GPIO_ALL_PINS_MASK).
+ * @return   : enumError_t - Error status indicating success or failure of setting the pins values.
+ * @details  : All the pins change with one write of BSRR , at the same clock & without read-modify-write
+ *             so it is safe against the interrupts changing other pins of the port.
+ *             The pins out of both masks keep their values , a pin in both masks is set (BSRR priority).
+ */
+enumError_t GPIO_Set_PortMask(void *Port , u32 SetMask , u32 ResetMask)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	/*Validate the input parameters*/
+
+	if(Port == NULL_PTR)
+	{
+		Ret_ErrorStatus= NullPointer;
+	}
+
+	else if ( !GPIO_IS_VALID_PORT(Port) )
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else if( (SetMask & ~GPIO_ALL_PINS_MASK) || (ResetMask & ~GPIO_ALL_PINS_MASK) )
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else
+	{
+		Ret_ErrorStatus = Ok;
+
+		/*First 16 bit set the pins and second 16 bit reset them , so one write changes the whole port*/
+		((volatile GPIO_PORT_t *)Port)->BSRR = (ResetMask << GPIO_BSRR_RESET_SHIFT) | SetMask;
+	}
+	return Ret_ErrorStatus;
+}
+
+/*
+ * @brief     : Gets the current values of all the pins of a port.
+ * @param[in] : Port - Pointer to the GPIO port (GPIO_PORTA B C D E H).
+ * @param[out]: PortValue - Pointer to a variable to store the values , bit n for pin n (1 for high, 0 for low).
+ * @return    : enumError_t - Error status indicating success or failure of reading the port value.
+ * @details   : All the pins are sampled by one read of IDR at the same clock.
+ */
+enumError_t GPIO_Get_PortValue(void *Port , u32 *PortValue)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	/*Validate the input parameters*/
+
+	if(Port == NULL_PTR || PortValue == NULL_PTR)
+	{
+		Ret_ErrorStatus= NullPointer;
+	}
+
+	else if ( !GPIO_IS_VALID_PORT(Port) )
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else
+	{
+		Ret_ErrorStatus = Ok;
+
+		/*The upper 16 bit of IDR are reserved*/
+		*PortValue = ( ((volatile GPIO_PORT_t *) Port)->IDR ) & GPIO_ALL_PINS_MASK;
+	}
+	return Ret_ErrorStatus;
+}
+
+#if GPIO_FAST_CHECK == GPIO_ENABLE
+/*
+ * @brief    : Called by the fast path on a wrong argument when GPIO_FAST_CHECK is enabled.
+ * @param[in]: None
+ * @return   : None
+ * @details  : Never returns , put a breakpoint in it & the call stack shows the wrong caller.
+ */
+void GPIO_FastCheckFailed(void)
+{
+	while(1)
+	{
+
+	}
+}
+#endif
+
+/*
+ * @brief    : Validates the configuration of a pin.
+ * @param[in]: Loc_GPIOElement - Pointer to a structure containing the GPIO pin configuration.
+ * @return   : enumError_t - Ok , NullPointer or WrongInput.
+ */
+static enumError_t GPIO_CheckConfig(const GPIO_Config_t *Loc_GPIOElement)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if(Loc_GPIOElement == NULL_PTR)
+	{
+		Ret_ErrorStatus= NullPointer;
+	}
+
+	else if(Loc_GPIOElement->Mood >GPIO_AF_OD_PD || Loc_GPIOElement->Speed >GPIO_VERY_HIGH_SPEED)
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else if(Loc_GPIOElement->AltFunc > GPIO_AF15)
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else if ( !GPIO_IS_VALID_PORT(Loc_GPIOElement->Port) )
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+
+	else if(Loc_GPIOElement->Pin > GPIO_PIN15)
+	{
+		Ret_ErrorStatus= WrongInput;
+	}
+	else
+	{
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+/*
+ * @brief    : Adds the fields of a validated pin configuration to the image of its port.
+ * @param[in]: Loc_GPIOElement - Pointer to the configuration of the pin.
+ * @param[in,out]: Image - Image of the port of the pin.
+ * @details  : The previous fields of the same pin in the image are replaced.
+ */
+static void GPIO_AddPinImage(const GPIO_Config_t *Loc_GPIOElement , GPIO_PortImage_t *Image)
+{
+	/* Getting the Mode value , Output Type , the value of pull-up/pull-down from the mask
+	 * By Anding with the Clear Mask And Shifting with this bits.
+	 * The first 2 bits --> Mode
+	 * The second 1 bit --> Output Type
+	 * The Third 2 bits --> PullUp Or PullDown
+	 */
+	u32 Loc_Mode_Value = (Loc_GPIOElement->Mood) & GPIO_MODE_MASK;
+	u32 Loc_OutType_Value = ( (Loc_GPIOElement->Mood) & GPIO_OUT_TYPE_MASK ) >> GPIO_OUT_TYPE_SHIFT ;
+	u32 Loc_Pull_Value = ( (Loc_GPIOElement->Mood) & GPIO_PULL_TYPE_MASK ) >> GPIO_PULL_TYPE_SHIFT;
+
+	/*Each Pin is represented by 2 bits , so we need to shift according to the pin number after multiplying it by 2 */
+	u32 loc_Shift_2Bits = (Loc_GPIOElement->Pin) * GPIO_GROUP_OF_2_BITS;
+	u32 loc_Mask_2Bits = GPIO_SET_2_BITS << loc_Shift_2Bits;
+	u32 loc_Mask_1Bit = GPIO_SET_1_BIT << (Loc_GPIOElement->Pin); /*OTYPER is represented by 1 bit only */
+
+	/*Each Pin is represented by 4 bits in AFRL (Pins 0 --> 7) or AFRH (Pins 8 --> 15) ,
+	 *the alternate function is only taken by the AF moods , the others go back to AF0 */
+	u32 loc_Shift_4Bits = ( (Loc_GPIOElement->Pin) % GPIO_AFR_PINS ) * GPIO_GROUP_OF_4_BITS;
+	u32 loc_Mask_4Bits = GPIO_SET_4_BITS << loc_Shift_4Bits;
+	u32 loc_AltFunc_Value = (Loc_Mode_Value == GPIO_MODE_AF) ? Loc_GPIOElement->AltFunc : GPIO_AF0;
+
+	/*Clear the fields of the pin then set them according to the provided configuration from the user*/
+	Image->Mask_2Bits |= loc_Mask_2Bits;
+	Image->Mask_1Bit  |= loc_Mask_1Bit;
+
+	Image->MODER   = (Image->MODER   & ~loc_Mask_2Bits) | (Loc_Mode_Value << loc_Shift_2Bits);
+	Image->PUPDR   = (Image->PUPDR   & ~loc_Mask_2Bits) | (Loc_Pull_Value << loc_Shift_2Bits);
+	Image->OSPEEDR = (Image->OSPEEDR & ~loc_Mask_2Bits) | (Loc_GPIOElement->Speed << loc_Shift_2Bits); /*Speed is not injected in the Mood */
+	Image->OTYPER  = (Image->OTYPER  & ~loc_Mask_1Bit)  | (Loc_OutType_Value << (Loc_GPIOElement->Pin));
+
+	if(Loc_GPIOElement->Pin < GPIO_AFR_PINS)
+	{
+		Image->Mask_AFRL |= loc_Mask_4Bits;
+		Image->AFRL = (Image->AFRL & ~loc_Mask_4Bits) | (loc_AltFunc_Value << loc_Shift_4Bits);
+	}
+	else
+	{
+		Image->Mask_AFRH |= loc_Mask_4Bits;
+		Image->AFRH = (Image->AFRH & ~loc_Mask_4Bits) | (loc_AltFunc_Value << loc_Shift_4Bits);
+	}
+}
+
+/*
+ * @brief    : Writes the image of a port to its registers.
+ * @param[in]: Port - Pointer to the GPIO port.
+ * @param[in]: Image - Image of the pins to be configured.
+ * @details  : One read-modify-write of every configuration register , the other pins keep their configuration.
+ */
+static void GPIO_WritePortImage(void *Port , const GPIO_PortImage_t *Image)
+{
+	volatile GPIO_PORT_t *loc_Port = (volatile GPIO_PORT_t *)Port;
+
+	/*The alternate function is selected before MODER hands the pin to the peripheral*/
+	loc_Port->AFRL    = (loc_Port->AFRL    & ~(Image->Mask_AFRL))  | Image->AFRL;
+	loc_Port->AFRH    = (loc_Port->AFRH    & ~(Image->Mask_AFRH))  | Image->AFRH;
+	loc_Port->OTYPER  = (loc_Port->OTYPER  & ~(Image->Mask_1Bit))  | Image->OTYPER;
+	loc_Port->OSPEEDR = (loc_Port->OSPEEDR & ~(Image->Mask_2Bits)) | Image->OSPEEDR;
+	loc_Port->PUPDR   = (loc_Port->PUPDR   & ~(Image->Mask_2Bits)) | Image->PUPDR;
+	loc_Port->MODER   = (loc_Port->MODER   & ~(Image->Mask_2Bits)) | Image->MODER;
+}
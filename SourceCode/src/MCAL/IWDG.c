@@ -0,0 +1,105 @@
+/*
+ ============================================================================
+ Name        : IWDG.c
+ Author      : Farah Mohey
+ Description : Source file for IWDG (Independent watchdog for STM32F401xC)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "MCAL/IWDG.h"
+
+/***************************** Definitions *************************************/
+#define IWDG_BASE_ADDRESS       0x40003000
+
+/*Keys written in KR */
+#define IWDG_KEY_START          0x0000CCCC		/*Starts the watchdog (& the LSI) */
+#define IWDG_KEY_REFRESH        0x0000AAAA		/*Reloads the counter */
+#define IWDG_KEY_ACCESS         0x00005555		/*Enables the write access to PR & RLR */
+
+#define IWDG_SR_BUSY_MASK       0x00000003		/*Bit0 PVU , Bit1 RVU --> Update of PR or RLR in progress */
+
+#define IWDG_MAX_COUNTS         0x00001000		/*RLR is 12 bits --> 4096 counts at most */
+#define IWDG_MIN_DIVIDER        4				/*PR = 0 --> LSI / 4 , every next value doubles the divider */
+#define IWDG_MAX_PRESCALER      6				/*PR = 6 --> LSI / 256 */
+
+#define MILLI_PER_SEC           1000
+#define N_COUNT                 1
+
+/**************************** Types Declaration ********************************/
+typedef struct
+{
+	u32 IWDG_KR;
+	u32 IWDG_PR;
+	u32 IWDG_RLR;
+	u32 IWDG_SR;
+} IWDG_PERI_t;
+
+
+/****************************** Variables **************************************/
+
+/* Pointer to the IWDG peripheral structure */
+volatile IWDG_PERI_t *const IWDG = (volatile IWDG_PERI_t *) IWDG_BASE_ADDRESS;
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Starts the independent watchdog.
+ * @param   : TimeoutMs - Time without refresh after which the microcontroller is reset (1 to IWDG_MAX_TIMEOUT_MS).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The smallest prescaler giving the timeout is selected , the timeout is rounded down to whole counts.
+ * 				Once started the watchdog can't be stopped (Only by a reset) & keeps counting in sleep mode.
+ */
+enumError_t IWDG_Init(u32 TimeoutMs)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Prescaler = 0;
+
+	/* Counts of the timeout with the smallest divider , halved by every step of the prescaler */
+	u64 loc_Counts = ( (u64)IWDG_LSI_FREQUENCY_HZ * TimeoutMs ) / (MILLI_PER_SEC * IWDG_MIN_DIVIDER);
+
+	while ( (loc_Counts > IWDG_MAX_COUNTS) && (loc_Prescaler < IWDG_MAX_PRESCALER) )
+	{
+		loc_Counts >>= 1;
+		loc_Prescaler++;
+	}
+
+	if ( (loc_Counts == 0) || (loc_Counts > IWDG_MAX_COUNTS) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		/* Start first (It enables the LSI) , then unlock PR & RLR */
+		IWDG->IWDG_KR = IWDG_KEY_START;
+		IWDG->IWDG_KR = IWDG_KEY_ACCESS;
+		IWDG->IWDG_PR = loc_Prescaler;
+		IWDG->IWDG_RLR = (u32)loc_Counts - N_COUNT;
+
+		/* The values are copied to the LSI domain , the counter is reloaded with the new value after it */
+		while (IWDG->IWDG_SR & IWDG_SR_BUSY_MASK)
+		{
+		}
+		IWDG->IWDG_KR = IWDG_KEY_REFRESH;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : Reloads the counter of the watchdog.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Must be called more often than the timeout to prevent the reset.
+ */
+enumError_t IWDG_Refresh(void)
+{
+	IWDG->IWDG_KR = IWDG_KEY_REFRESH;
+
+	return Ok;
+}
@@ -0,0 +1,455 @@
+/*
+ ============================================================================
+ Name        : NVIC.c
+ Author      : Farah Mohey
+ Description : Source file for NVIC (Nested vectored interrupt controller for STM32F401xC)
+ Created	 : 27-Mar-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "MCAL/NVIC.h"
+#include "LIB/CortexM4_Core.h"
+
+/***************************** Definitions *************************************/
+#define NVIC_BASE_ADDRESS       0xE000E100
+#define SCB_ICSR_ADDRESS        0xE000ED04		/*Interrupt control and state register */
+#define SCB_AIRCR_ADDRESS       0xE000ED0C		/*Application interrupt and reset control register */
+#define SCB_SHPR_ADDRESS        0xE000ED18		/*System handler priority registers , starting from exception 4 */
+
+#define NVIC_REG_BITS           32				/*Each register of ISER , ICER ... handles 32 interrupts */
+
+#define ICSR_PENDSVSET_MASK     BIT28_MASK		/*Bit28 = 1 --> Changes PendSV exception state to pending */
+
+#define AIRCR_VECTKEY           0x05FA0000		/*Register key , writes without it are ignored */
+#define AIRCR_PRIGROUP_MASK     0x00000700		/*Bits 10:8 --> Priority grouping kept by the reset request */
+#define AIRCR_SYSRESETREQ_MASK  BIT2_MASK		/*Bit2 = 1 --> Requests a system level reset */
+
+#define SHPR_FIRST_EXCEPTION    4				/*SHPR1 starts with the priority of exception 4 (MemManage) */
+
+/*STM32F401 implements only the upper 4 bits of each priority field */
+#define PRIORITY_IMPLEMENTED_BITS   4
+#define PRIORITY_SHIFT              4
+
+#define PRIGROUP_SHIFT          8				/*PRIGROUP --> Bits 10:8 of AIRCR */
+#define PRIGROUP_VAL_MASK       0x00000007
+#define PRIGROUP_NO_SUB         3				/*PRIGROUP <= 3 --> All the implemented bits are Preempt bits */
+
+#define NVIC_IS_VALID_GROUP(Group)	( ((Group) == PRIORITY_GROUP0) || ((Group) == PRIORITY_GROUP1) || ((Group) == PRIORITY_GROUP2) \
+									|| ((Group) == PRIORITY_GROUP3) || ((Group) == PRIORITY_GROUP5) )
+
+
+/**************************** Types Declaration ********************************/
+typedef struct
+{
+	u32 NVIC_ISER[8];
+	u32 Reserved0[24];
+	u32 NVIC_ICER[8];
+	u32 Reserved1[24];
+	u32 NVIC_ISPR[8];
+	u32 Reserved2[24];
+	u32 NVIC_ICPR[8];
+	u32 Reserved3[24];
+	u32 NVIC_IABR[8];
+	u32 Reserved4[56];
+	u8  NVIC_IPR[240];
+	u32 Reserved5[644];
+	u32 NVIC_STIR;
+} NVIC_PERI_t;
+
+
+/****************************** Variables **************************************/
+
+/* Pointer to the NVIC peripheral structure */
+volatile NVIC_PERI_t *const NVIC = (volatile NVIC_PERI_t *) NVIC_BASE_ADDRESS;
+
+/* Pointers to the system control block registers */
+volatile u32 *const NVIC_SCB_ICSR  = (volatile u32 *) SCB_ICSR_ADDRESS;
+volatile u32 *const NVIC_SCB_AIRCR = (volatile u32 *) SCB_AIRCR_ADDRESS;
+volatile u8  *const NVIC_SCB_SHPR  = (volatile u8 *)  SCB_SHPR_ADDRESS;
+
+
+/************************ Static Function Prototypes ***************************/
+
+static enumError_t NVIC_EncodePriority(u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority , u8 *Priority);
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief    : Enable NVIC IRQ
+ * @param[in]: IRQn - Interrupt number
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Enables the specified NVIC interrupt.
+ */
+enumError_t NVIC_Enable_IRQ (IRQn_t IRQn)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+
+	/* Writing 0 has no effect --> No need to read the register first */
+	else
+	{
+		NVIC->NVIC_ISER[IRQn / NVIC_REG_BITS] = BIT0_MASK << (IRQn % NVIC_REG_BITS);
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Disable NVIC IRQ
+ * @param[in]: IRQn - Interrupt number
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Disables the specified NVIC interrupt.
+ */
+enumError_t NVIC_Disable_IRQ(IRQn_t IRQn)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		NVIC->NVIC_ICER[IRQn / NVIC_REG_BITS] = BIT0_MASK << (IRQn % NVIC_REG_BITS);
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set NVIC Pending IRQ
+ * @param[in]: IRQn - Interrupt number
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Sets the specified NVIC interrupt as pending.
+ */
+enumError_t NVIC_SetPending_IRQ(IRQn_t IRQn)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		NVIC->NVIC_ISPR[IRQn / NVIC_REG_BITS] = BIT0_MASK << (IRQn % NVIC_REG_BITS);
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Clear NVIC Pending IRQ
+ * @param[in]: IRQn - Interrupt number
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Clears the pending status of the specified NVIC interrupt.
+ */
+enumError_t NVIC_ClearPending_IRQ(IRQn_t IRQn)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		NVIC->NVIC_ICPR[IRQn / NVIC_REG_BITS] = BIT0_MASK << (IRQn % NVIC_REG_BITS);
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Get NVIC Pending IRQ status
+ * @param[in]: IRQn - Interrupt number
+ * @param[in]: *Ptr_IRQ - Pointer to store the status
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Retrieves the pending status of the specified NVIC interrupt.
+ */
+enumError_t NVIC_GetPending_IRQ(IRQn_t IRQn, u8 *Ptr_IRQ)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Ptr_IRQ == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Ptr_IRQ = (u8)( ( NVIC->NVIC_ISPR[IRQn / NVIC_REG_BITS] >> (IRQn % NVIC_REG_BITS) ) & BIT0_MASK );
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Get NVIC Active IRQ status
+ * @param[in]: IRQn - Interrupt number
+ * @param[in]: *Ptr_IRQ - Pointer to store the status
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Retrieves the active status of the specified NVIC interrupt.
+ */
+enumError_t NVIC_GetActive_IRQ(IRQn_t IRQn, u8 *Ptr_IRQ)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Ptr_IRQ == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Ptr_IRQ = (u8)( ( NVIC->NVIC_IABR[IRQn / NVIC_REG_BITS] >> (IRQn % NVIC_REG_BITS) ) & BIT0_MASK );
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set the Priority Grouping
+ * @param[in]: GroupPriority - Group priority value (PRIORITY_GROUP0 ... PRIORITY_GROUP5)
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Writes PRIGROUP of AIRCR , called once at startup before setting the priorities
+ * 				(PRIORITY_GROUP0 is the reset value).
+ */
+enumError_t NVIC_SetPriorityGrouping(u32 GroupPriority)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (!NVIC_IS_VALID_GROUP(GroupPriority))
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		/* The register key is included in the group value */
+		*NVIC_SCB_AIRCR = GroupPriority;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set Interrupt Priority
+ * @param[in]: IRQn - Interrupt number
+ * @param[in]: PreemptGroup - Preemption priority group
+ * @param[in]: SubpriorityGroup - Subpriority group
+ * @param[in]: GroupPriority - Group priority value , must be the grouping set by NVIC_SetPriorityGrouping
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Sets the priority level for the specified NVIC interrupt.
+ */
+enumError_t NVIC_SetPriority(IRQn_t IRQn, u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority )
+{
+	u32 Ret_ErrorStatus = Nok;
+	u8 loc_Priority = 0;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Ret_ErrorStatus = NVIC_EncodePriority(PreemptGroup , SubpriorityGroup , GroupPriority , &loc_Priority);
+		if (Ret_ErrorStatus == Ok)
+		{
+			NVIC->NVIC_IPR[IRQn] = loc_Priority;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Get Interrupt Priority
+ * @param[in]: IRQn - Interrupt number
+ * @param[in]: Ptr_priorityLEV - Pointer to store the priority level
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Retrieves the priority level of the specified NVIC interrupt.
+ */
+enumError_t NVIC_GetPriority(IRQn_t IRQn, u8 *Ptr_priorityLEV)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Ptr_priorityLEV == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Ptr_priorityLEV = NVIC->NVIC_IPR[IRQn] >> PRIORITY_SHIFT;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Generate a Software  Interrupt
+ * @param[in]: IRQn - Interrupt number
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : The value to be written is the Interrupt ID of the required SGI, in the range 0-239.
+ * 				For example, a value of 0x03 specifies interrupt IRQ3.
+ */
+enumError_t NVIC_SetSoftware_Interrupt(IRQn_t IRQn)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (IRQn >= _INT_Num)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		NVIC->NVIC_STIR = IRQn;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set System Exception Priority
+ * @param[in]: SysException - NVIC_SYS_PENDSV or NVIC_SYS_SYSTICK
+ * @param[in]: PreemptGroup - Preemption priority group
+ * @param[in]: SubpriorityGroup - Subpriority group
+ * @param[in]: GroupPriority - Group priority value , must be the grouping set by NVIC_SetPriorityGrouping
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Same as NVIC_SetPriority for the system exceptions which are configured in the system control block.
+ */
+enumError_t NVIC_SetSystemPriority(u8 SysException, u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority )
+{
+	u32 Ret_ErrorStatus = Nok;
+	u8 loc_Priority = 0;
+
+	if ( (SysException != NVIC_SYS_PENDSV) && (SysException != NVIC_SYS_SYSTICK) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Ret_ErrorStatus = NVIC_EncodePriority(PreemptGroup , SubpriorityGroup , GroupPriority , &loc_Priority);
+		if (Ret_ErrorStatus == Ok)
+		{
+			NVIC_SCB_SHPR[SysException - SHPR_FIRST_EXCEPTION] = loc_Priority;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set PendSV Pending
+ * @param[in]: None
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Requests the PendSV exception , its handler runs once no higher priority exception is active.
+ */
+enumError_t NVIC_SetPending_PendSV(void)
+{
+	/* Writing 0 to the other bits of ICSR has no effect */
+	*NVIC_SCB_ICSR = ICSR_PENDSVSET_MASK;
+
+	return Ok;
+}
+
+
+/*
+ * @brief    : Resets the microcontroller
+ * @param[in]: None
+ * @return   : None - It never returns
+ * @details  : Requests a system reset (SYSRESETREQ of AIRCR) keeping the priority grouping.
+ */
+void NVIC_SystemReset(void)
+{
+	/* Complete the pending writes (e.g. a log in RAM kept through the reset) before requesting it */
+	Core_DataSyncBarrier();
+	*NVIC_SCB_AIRCR = AIRCR_VECTKEY | (*NVIC_SCB_AIRCR & AIRCR_PRIGROUP_MASK) | AIRCR_SYSRESETREQ_MASK;
+	Core_DataSyncBarrier();
+
+	/* Wait for the reset */
+	while (1)
+	{
+	}
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief    : Builds the value of a priority field.
+ * @param[in]: PreemptGroup - Preemption priority group
+ * @param[in]: SubpriorityGroup - Subpriority group
+ * @param[in]: GroupPriority - Group priority value (PRIORITY_GROUP0 ... PRIORITY_GROUP5)
+ * @param[out]: Priority - Value to be written in the 8 bits priority field
+ * @return   : enumError_t - WrongInput if the group is not valid or not the one set in AIRCR ,
+ *             or if a value does not fit in its bits.
+ * @details  : AIRCR is only read , the grouping is written once by NVIC_SetPriorityGrouping.
+ */
+static enumError_t NVIC_EncodePriority(u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority , u8 *Priority)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_PriGroup;
+	u32 loc_SubBits = 0;
+
+	if ( (!NVIC_IS_VALID_GROUP(GroupPriority)) || ((*NVIC_SCB_AIRCR & AIRCR_PRIGROUP_MASK) != (GroupPriority & AIRCR_PRIGROUP_MASK)) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		/* Number of Subpriority bits among the 4 implemented bits according to PRIGROUP */
+		loc_PriGroup = (GroupPriority >> PRIGROUP_SHIFT) & PRIGROUP_VAL_MASK;
+		if (loc_PriGroup > PRIGROUP_NO_SUB)
+		{
+			loc_SubBits = loc_PriGroup - PRIGROUP_NO_SUB;
+		}
+
+		if ( (PreemptGroup >> (PRIORITY_IMPLEMENTED_BITS - loc_SubBits)) || (SubpriorityGroup >> loc_SubBits) )
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else
+		{
+			*Priority = (u8)( ( (PreemptGroup << loc_SubBits) | SubpriorityGroup ) << PRIORITY_SHIFT );
+			Ret_ErrorStatus = Ok;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
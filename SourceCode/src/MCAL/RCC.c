@@ -14,12 +14,24 @@
 #define RCC_Base_ADDRESS 	0x40023800
 
 #define STATUS_SYSCLK_MASK	0x0000000C	/*read sysclk */
+#define STATUS_SYSCLK_SHIFT	2			/*SWS = bit 2,3 , same coding of SW */
 #define	SYSCLK_CLR_MASK		0xFFFFFFFC 	/*Clear bit 0,1*/
+#define SYSCLK_SWITCH_TIMEOUT	1000	/*Polls of SWS waiting for the switch */
 
 #define APBH_PRE_CLR_MASK   0XFFFF1FFF	 /* clearing bit 13,14,15 */
 #define APBL_PRE_CLR_MASK   0XFFFFE3FF	 /* clearing bit 10,11,12 */
 
 #define AHB_PRE_CLR_MASK    0XFFFFFF0F	/* clearing bit 4,5,6,7 */
+#define AHB_PRE_SHIFT		4			/* HPRE starts from bit4 */
+#define AHB_PRE_DIV_MASK	BIT3_MASK	/* HPRE = 0xxx --> not divided , 1xxx --> divided by AhbDividers[xxx] */
+#define AHB_PRE_IDX_MASK	0x7
+
+/**************** Clock frequencies ******************/
+#define HSI_FREQUENCY_HZ	16000000
+
+#define PLL_M_MASK			0x3F		/*PLLM bit0-->bit5 */
+#define PLL_N_MASK			0x1FF		/*PLLN bit6-->bit14 after shifting */
+#define PLL_P_MASK			0x3			/*PLLP bit16 & bit17 after shifting */
 
 /**************** PLL Config ******************/
 #define PLL_SRC_CLR_MASK 	0xFFBFFFFF /*Clear bit 22 */
@@ -89,6 +101,17 @@ typedef struct
 /**************************** Variables	***************************************/
 volatile RCC_PERI_t * const RCC = (volatile RCC_PERI_t *) RCC_Base_ADDRESS;
 
+/* Division factors of HPRE = 1000 --> 1111 */
+static const u16 AhbDividers[] = { 2 , 4 , 8 , 16 , 64 , 128 , 256 , 512 };
+
+/* Callbacks notified when HCLK changes */
+static RCC_CBF_t ClockChangeCBF[RCC_MAX_CLOCK_CALLBACKS];
+
+
+/************************ Static Function Prototypes ***************************/
+
+static void RCC_NotifyClockChange(void);
+
 
 /************************** Functions Implementation *******************************/
 
@@ -216,6 +239,23 @@ enumError_t RCC_Select_SysClk(u32 SYSCLK)
 		loc_CFGR_Temp &= SYSCLK_CLR_MASK; 	/* Clear the bits related to system clock configuration. */
 		loc_CFGR_Temp |= SYSCLK; 			/* Set the bits for the selected system clock source. */
 		RCC->RCC_CFGR = loc_CFGR_Temp; 		/* ReAllocate Temp to CFGR register with the new SysCLK value */
+
+		/* Wait till the hardware reports the switch (SWS) , a clock not ready is not switched to */
+		u16 loc_TimeOut = SYSCLK_SWITCH_TIMEOUT;
+		while (loc_TimeOut && ((RCC->RCC_CFGR & STATUS_SYSCLK_MASK) != (SYSCLK << STATUS_SYSCLK_SHIFT)))
+		{
+			loc_TimeOut--;
+		}
+
+		if ((RCC->RCC_CFGR & STATUS_SYSCLK_MASK) != (SYSCLK << STATUS_SYSCLK_SHIFT))
+		{
+			Ret_ErrorStatus = RCC_ClkNotReady;
+		}
+		else
+		{
+			/* The users of HCLK recompute their timings */
+			RCC_NotifyClockChange();
+		}
 	}
 
 	return Ret_ErrorStatus;
@@ -233,6 +273,96 @@ u32 RCC_Read_SysClk(void)
 	return loc_CFGR_Temp ;
 }
 
+/*
+ * @brief    : Get System Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , SYSCLK in Hz.
+ * @details  : The PLL output is Source / PLLM * PLLN / PLLP , exact when the source is a multiple of PLLM
+ *             (The VCO input of 1 or 2 MHz recommended by the reference manual).
+ */
+u32 RCC_Get_SysClkFreq(void)
+{
+	u32 Ret_Freq = HSI_FREQUENCY_HZ;
+	u32 loc_PLLCFGR_Temp;
+	u32 loc_PllInput;
+	u32 loc_M;
+	u32 loc_N;
+	u32 loc_P;
+
+	switch ((RCC->RCC_CFGR & STATUS_SYSCLK_MASK) >> STATUS_SYSCLK_SHIFT)
+	{
+	case SYSCLK_HSE:
+		Ret_Freq = RCC_HSE_FREQUENCY_HZ;
+		break;
+
+	case SYSCLK_PLL:
+		loc_PLLCFGR_Temp = RCC->RCC_PLLCFGR;
+		loc_PllInput = (loc_PLLCFGR_Temp & PLL_SRC_HSE) ? RCC_HSE_FREQUENCY_HZ : HSI_FREQUENCY_HZ;
+		loc_M = loc_PLLCFGR_Temp & PLL_M_MASK;
+		loc_N = (loc_PLLCFGR_Temp >> PLL_N_SHIFTING) & PLL_N_MASK;
+		loc_P = ( ((loc_PLLCFGR_Temp >> PLL_P_SHIFTING) & PLL_P_MASK) + 1 ) * 2;	/* 00 --> 2 , 01 --> 4 , 10 --> 6 , 11 --> 8 */
+
+		/* PLLM of 0 or 1 is a wrong configuration , avoid the division by zero */
+		Ret_Freq = (loc_M < PLLM_BOUNDARY1) ? 0 : ( ((loc_PllInput / loc_M) * loc_N) / loc_P );
+		break;
+
+	default:
+		/* HSI */
+		break;
+	}
+
+	return Ret_Freq;
+}
+
+/*
+ * @brief    : Get AHB Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , HCLK in Hz (Clock of the processor , the SysTick & the DWT cycle counter).
+ * @details  : SYSCLK divided by the AHB prescaler read from HPRE.
+ */
+u32 RCC_Get_HclkFreq(void)
+{
+	u32 loc_Hpre = (RCC->RCC_CFGR >> AHB_PRE_SHIFT) & (AHB_PRE_DIV_MASK | AHB_PRE_IDX_MASK);
+	u32 Ret_Freq = RCC_Get_SysClkFreq();
+
+	if (loc_Hpre & AHB_PRE_DIV_MASK)
+	{
+		Ret_Freq /= AhbDividers[loc_Hpre & AHB_PRE_IDX_MASK];
+	}
+
+	return Ret_Freq;
+}
+
+/*
+ * @brief    : Add a callback notified when HCLK changes.
+ * @param	 : CallBack , Function called after the system clock is switched or the AHB prescaler is changed.
+ * @return   : enumError_t , Error status (Nok --> RCC_MAX_CLOCK_CALLBACKS already added).
+ * @details  : Adding a callback again has no effect.
+ */
+enumError_t RCC_AddClockChangeCallBack(RCC_CBF_t CallBack)
+{
+	enumError_t Ret_ErrorStatus = Nok;
+	u32 loc_idx;
+
+	if (CallBack == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		for (loc_idx = 0 ; (loc_idx < RCC_MAX_CLOCK_CALLBACKS) && (Ret_ErrorStatus != Ok) ; loc_idx++)
+		{
+			if ( (ClockChangeCBF[loc_idx] == NULL_PTR) || (ClockChangeCBF[loc_idx] == CallBack) )
+			{
+				ClockChangeCBF[loc_idx] = CallBack;
+				Ret_ErrorStatus = Ok;
+			}
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
 /*
  * @brief    : Configure PLL Source.
  * @param	 : Copy_PLLSrc The PLL source to be configured. It can be PLL_SRC_HSI or PLL_SRC_HSE.
@@ -402,6 +532,9 @@ enumError_t RCC_Config_AHB_BusPrescaler (u32  AHB_PreScalerValue)
 		loc_CFGR_Temp &= AHB_PRE_CLR_MASK; 		/* Clear the bits*/
 		loc_CFGR_Temp |= AHB_PreScalerValue;	/* Set the bits for the AHB PreScaler Value*/
 		RCC->RCC_CFGR = loc_CFGR_Temp;		/* ReAllocate Temp to CFGR register with the new PreScaler Value*/
+
+		/* HCLK changed --> The users recompute their timings */
+		RCC_NotifyClockChange();
 	}
 	return Ret_ErrorStatus;
 }
@@ -584,3 +717,22 @@ enumError_t RCC_Disable_APB2_Peripheral(u32 APB2_PeripheralName)
 	return Ret_ErrorStatus;
 
 }
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief    : Notify the clock change callbacks.
+ * @param	 : void
+ * @return   : void
+ * @details  : Called after HCLK changed , the callbacks are called in their order of adding.
+ */
+static void RCC_NotifyClockChange(void)
+{
+	u32 loc_idx;
+
+	for (loc_idx = 0 ; (loc_idx < RCC_MAX_CLOCK_CALLBACKS) && (ClockChangeCBF[loc_idx] != NULL_PTR) ; loc_idx++)
+	{
+		ClockChangeCBF[loc_idx]();
+	}
+}
@@ -9,21 +9,36 @@
 
 /******************************** Includes **************************************/
 #include "MCAL/STK.h"
+#include "MCAL/RCC.h"
+#include "LIB/CortexM4_Core.h"
 
 /***************************** Definitions *************************************/
 #define STK_BASE_ADDRESS        0xE000E010
+#define SCB_ICSR_ADDRESS        0xE000ED04		/*Interrupt control and state register */
 
 #define STK_START_STOP_MASK     BIT0_MASK		/*Bit0 = 1*/
 #define STK_MODE_CLR_MASK       0xFFFFFFF9		/*Bit1 = 0 , Bit2= 0*/
 #define CLK_SRC_MASK            BIT2_MASK		/*Bit2 = 1 */
+#define COUNT_FLAG_MASK         BIT16_MASK		/*Bit16 = 1 */
+#define COUNT_FLAG_SHIFT        16
+
+#define ICSR_PENDSTCLR_MASK     BIT25_MASK		/*Bit25 = 1 --> Removes the pending state from the SysTick exception */
+#define ICSR_PENDSTSET_MASK     BIT26_MASK		/*Bit26 = 1 --> The SysTick exception is pending */
 
 /*Range of SYSTICK 0-->24 , 2 pwr 24 = 16 million */
 #define RELOAD_MIN_TIME     BIT0_MASK		/*Bit0 = 1*/
 #define RELOAD_MAX_TIME     0x00FFFFFF		/*from bit 0- 24 =1 */
 
 #define MICRO_TO_MILLI     1000
+#define MICRO_TO_SEC       1000000
 #define N_COUNT            1
 
+/*Processor cycles of one count of the AHB/8 source */
+#define STK_AHB_8_DIVIDER      8
+
+/*Longest period set in time units , longer than the 24 bit RELOAD at any clock */
+#define STK_MAX_PERIOD_MS      (0xFFFFFFFF / MICRO_TO_MILLI)
+
 /**************************** Types Declaration ********************************/
 typedef struct
 {
@@ -33,15 +48,63 @@ typedef struct
 	u32 STK_CALIB;
 } STK_PERI_t;
 
+/*Time of the SysTick periods completed , the time of the current period is added from VAL by the readers */
+typedef struct
+{
+	u64 Us;			/* Microseconds since the start */
+	u32 Ms;			/* Milliseconds since the start , wraps around */
+	u32 UsInMs;		/* Microseconds not yet a whole millisecond */
+	u32 Cycles;		/* Processor cycles not yet a whole microsecond */
+} STK_TimeBase_t;
+
 
 /****************************** Variables **************************************/
 
 /* Pointer to the SysTick peripheral structure */
-volatile STK_PERI_t *const STK = (volatile STK_PERI_t *) STK_BASE_ADDRESS;
+static volatile STK_PERI_t *const STK = (volatile STK_PERI_t *) STK_BASE_ADDRESS;
+
+/* Pointer to the interrupt control and state register of the system control block */
+static volatile u32 *const SCB_ICSR = (volatile u32 *) SCB_ICSR_ADDRESS;
 
 /* Callback function pointer for SysTick interrupt */
 static STK_CBF_t APP_CBF = NULL_PTR ;
 
+/* Callbacks added by STK_AddCallBack , executed after APP_CBF */
+static STK_CBF_t AddedCBF[STK_MAX_ADDED_CALLBACKS];
+
+/* Timebase double buffered : The writer fills the copy not in use then publishes it by one word (TimeBaseSeq) ,
+ * so a reader (Even an interrupt preempting the writer) always copies a complete one */
+static volatile STK_TimeBase_t TimeBase[2];
+static volatile u32 TimeBaseSeq;
+
+/* Processor cycles of one count of the SysTick clock (1 --> AHB , 8 --> AHB/8) */
+static volatile u32 CyclesPerCount = STK_AHB_8_DIVIDER;
+
+/* Processor cycles of one microsecond , from HCLK read from RCC (CLK_FREQUENCY_MHZ till the first STK_SetConfig) */
+static volatile u32 CyclesPerUs = CLK_FREQUENCY_MHZ / MICRO_TO_SEC;
+
+/* Period set by STK_SetTimeMs / STK_SetTimeUs , recomputed when HCLK changes (0 --> Not set in time units) */
+static u32 PeriodUs;
+
+/* The pending SysTick exception was already added to the timebase by a change of the period */
+static volatile u8 WrapAccounted;
+
+/* PeriodUs didn't fit in the RELOAD at the last HCLK , the previous RELOAD is running (Read by STK_GetStatus) */
+static volatile u8 PeriodOutOfRange;
+
+/* STK_ClockChanged is in the callbacks of RCC (Added once by the first STK_SetConfig) */
+static u8 ClockCallBackAdded;
+
+
+/************************ Static Function Prototypes ***************************/
+
+static void STK_AddCounts(u32 Counts);
+static void STK_AccountPeriod(void);
+static u32  STK_ReadTimeBase(STK_TimeBase_t *Base);
+static enumError_t STK_LoadPeriodUs(u32 TimeUs);
+static void STK_ClockChanged(void);
+static void STK_UpdateCyclesPerUs(void);
+
 
 /***************************** Implementation **********************************/
 
@@ -124,18 +187,32 @@ enumError_t STK_SetConfig(u32 Mode)
 
 	}
 
+	/* The periods are calculated from the real HCLK & recalculated whenever it changes ,
+	 * the callback is added once before touching the registers so a full table of RCC leaves them unchanged */
+	else if ( (ClockCallBackAdded == 0) && (RCC_AddClockChangeCallBack(STK_ClockChanged) != Ok) )
+	{
+		Ret_ErrorStatus = Nok;
+	}
+
 	/* Store the current value of STK_CTRL register in Temp Variable to keep its value
 	 * SET the bit2 = CLKSOURCE & bit1 = TICKINT in CTRL Register by | with Mode
 	 * Re-Assign modified value back to CTRL Register
 	 */
 	else
 	{
+		ClockCallBackAdded = 1;
+
+		/* The elapsed counts of the current period are taken with the old clock source */
+		STK_AccountPeriod();
+
 		u32 loc_Temp_Config = STK->STK_CTRL;
 		loc_Temp_Config &= (STK_MODE_CLR_MASK);
 		loc_Temp_Config |= Mode ;
 		STK->STK_CTRL = loc_Temp_Config ;
 
-		/*Setting error status to OK after setting the Mode in CTRL Register */
+		CyclesPerCount = (Mode & CLK_SRC_MASK) ? 1 : STK_AHB_8_DIVIDER;
+
+		STK_UpdateCyclesPerUs();
 		Ret_ErrorStatus = Ok;
 	}
 
@@ -149,62 +226,158 @@ enumError_t STK_SetConfig(u32 Mode)
  * @return  : Error status indicating success or failure.
  * @details : This function sets the time interval for the SysTick timer,
  * 				which determines the period between interrupts generated by the timer.
+ * 				The counts are calculated from HCLK read from RCC & recalculated automatically when it changes.
  */
 enumError_t STK_SetTimeMs(u32 TimeMs)
 {
 	u32 Ret_ErrorStatus = Nok;
 
-	/* Calculate the microcontroller clock in Micro */
-	u32 MicroClk = 0;
-	if ( (STK->STK_CTRL) & (CLK_SRC_MASK) )
+	/* Longer than the 24 bit RELOAD at any clock , checked before the conversion to microseconds to avoid its overflow */
+	if (TimeMs > STK_MAX_PERIOD_MS)
 	{
-		/*  Bit 2 CLKSOURCE: Clock source selection
-			1: Processor clock (AHB) */
-		MicroClk = CLK_FREQUENCY_MHZ;
+		Ret_ErrorStatus = WrongInput;
 	}
 	else
 	{
-		/*  Bit 2 CLKSOURCE: Clock source selection
-			0: AHB/8   */
-
-		MicroClk = CLK_FREQUENCY_MHZ/8;
+		Ret_ErrorStatus = STK_LoadPeriodUs(TimeMs * MICRO_TO_MILLI);
 	}
 
+	/* Return the error status */
+	return Ret_ErrorStatus;
+}
 
-	/* Calculate the reload value for the given time interval */
 
-	/* Convert Clk from Micro to Milli --> MicroClk / MICRO_TO_MILLI
-	 * Multiplying Clk after conversion with Required Time set by user --> * TimeMs
-	 * Use a RELOAD value of N-1.
-	 * For example, if the SysTick interrupt is required every 100 clock pulses, set RELOAD to 99
-	 * Then -1 --> N_COUNT
-	 */
+/*
+ * @brief   : Sets the time interval for the SysTick timer in microseconds.
+ * @param   : TimeUs - The time interval in microseconds.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Same as STK_SetTimeMs for periods finer than 1 ms , the counts are calculated in 64 bits
+ * 				so the interval is exact whenever it is a whole number of clock cycles (e.g. 250 us at AHB/8).
+ */
+enumError_t STK_SetTimeUs(u32 TimeUs)
+{
+	return STK_LoadPeriodUs(TimeUs);
+}
 
-	u32 Temp_Load = ( (MicroClk/ MICRO_TO_MILLI) * TimeMs ) - N_COUNT ;
 
+/*
+ * @brief   : Sets the RELOAD value of the SysTick timer directly in timer counts.
+ * @param   : ReloadVal - Number of counts of the period - 1 (from 1 to STK_MAX_RELOAD_VAL).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The current value is cleared so the new period starts counting immediately.
+ */
+enumError_t STK_SetReloadVal(u32 ReloadVal)
+{
+	u32 Ret_ErrorStatus = Nok;
 
-	/* Check if the provided time interval is within the valid range */
 	/*Range of SYSTICK 0-->24 , 2 pwr 24 = 16 million */
-	if (Temp_Load < RELOAD_MIN_TIME || Temp_Load > RELOAD_MAX_TIME)
+	if (ReloadVal < RELOAD_MIN_TIME || ReloadVal > RELOAD_MAX_TIME)
 	{
 		Ret_ErrorStatus = WrongInput;
 	}
 
 	else
 	{
-		/* Set the reload value and clear the current value in VAL register to avoid and corruption from old values */
-
-		STK->STK_LOAD = Temp_Load;
+		/* Set the reload value and clear the current value in VAL register to start the new period */
+		STK_AccountPeriod();
+		STK->STK_LOAD = ReloadVal;
 		STK->STK_VAL = 0;
 
 		Ret_ErrorStatus = Ok;
 	}
 
-	/* Return the error status */
 	return Ret_ErrorStatus;
 }
 
 
+/*
+ * @brief   : Get Value of LOAD Register - Counts of the current period - 1.
+ * @param   : *Reload_Val - Pointer to store in it the value.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_GET_ReloadVal(u32 *Reload_Val)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	/*Checking if the pointer is null pointer */
+	if (Reload_Val == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+
+	/*Storing the value of LOAD register in Reload_Val*/
+	else
+	{
+		*Reload_Val = STK->STK_LOAD;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus ;
+}
+
+
+/*
+ * @brief   : Get Value of COUNTFLAG - If the timer counted to 0 since the last time it was read.
+ * @param   : *Count_Flag - Pointer to store in it the flag (1 --> counted to 0 , 0 --> not).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Reading the flag clears it.
+ */
+enumError_t STK_GET_CountFlag(u8 *Count_Flag)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	/*Checking if the pointer is null pointer */
+	if (Count_Flag == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+
+	/*Reading COUNTFLAG bit from CTRL register , the hardware clears it after the read */
+	else
+	{
+		*Count_Flag = (u8)( ( (STK->STK_CTRL) & COUNT_FLAG_MASK ) >> COUNT_FLAG_SHIFT );
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus ;
+}
+
+
+/*
+ * @brief   : Gets whether the SysTick runs the period set in time units.
+ * @param   : None
+ * @return  : enumError_t - Ok , STK_PeriodOutOfRange (The period set by STK_SetTimeMs / STK_SetTimeUs doesn't fit in
+ * 				the RELOAD at the HCLK of the last clock change , the previous RELOAD is running).
+ * @details : Cleared by the next period loaded successfully (STK_SetTimeMs / STK_SetTimeUs or a later clock change).
+ */
+enumError_t STK_GetStatus(void)
+{
+	return (PeriodOutOfRange != 0) ? STK_PeriodOutOfRange : Ok;
+}
+
+
+/*
+ * @brief   : Clears the pending state of the SysTick exception.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Used when the expired period is already handled so the handler should not be executed for it.
+ */
+enumError_t STK_ClearPending(void)
+{
+	/* The handler won't count the expired period --> added to the timebase here */
+	if ( ((*SCB_ICSR) & ICSR_PENDSTSET_MASK) && (WrapAccounted == 0) )
+	{
+		STK_AddCounts(STK->STK_LOAD + N_COUNT);
+	}
+	WrapAccounted = 0;
+
+	/* ICSR is write 1 to clear for PENDSTCLR , writing 0 to the other bits has no effect */
+	*SCB_ICSR = ICSR_PENDSTCLR_MASK;
+
+	return Ok;
+}
+
+
 /*
  * @brief   : Get Current Value of VAL Register - Remaining Time for SYSTICK.
  * @param   : *Curr_Val - Pointer to access register and store in it the value.
@@ -260,6 +433,36 @@ enumError_t STK_SetCallBack(STK_CBF_t CallBack)
 	return Ret_ErrorStatus;
 }
 
+/*
+ * @brief   : Adds a callback function for the SysTick timer interrupt.
+ * @param   : CallBack - Pointer to the callback function.
+ * @return  : enumError_t - Indicating Status of the operation (Nok --> STK_MAX_ADDED_CALLBACKS already added).
+ * @details : Called before the users of the SysTick start , the list is read by the handler without a lock.
+ */
+enumError_t STK_AddCallBack(STK_CBF_t CallBack)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_idx;
+
+	if (CallBack == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		for (loc_idx = 0 ; (loc_idx < STK_MAX_ADDED_CALLBACKS) && (Ret_ErrorStatus != Ok) ; loc_idx++)
+		{
+			if ( (AddedCBF[loc_idx] == NULL_PTR) || (AddedCBF[loc_idx] == CallBack) )
+			{
+				AddedCBF[loc_idx] = CallBack;
+				Ret_ErrorStatus = Ok;
+			}
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
 
 /*
  * @brief   : SysTick interrupt handler.
@@ -272,10 +475,231 @@ enumError_t STK_SetCallBack(STK_CBF_t CallBack)
  */
 void SysTick_Handler(void)
 {
+	u32 loc_idx;
+
+	/* The period which expired is added to the timebase first , unless a change of the period already did */
+	if (WrapAccounted)
+	{
+		WrapAccounted = 0;
+	}
+	else
+	{
+		STK_AddCounts(STK->STK_LOAD + N_COUNT);
+	}
+
 	/* Check if a callback function is registered */
 if (APP_CBF)
 {
     /* Call the registered callback function */
     APP_CBF();
 }
+
+	/* Then the added ones till the first empty slot */
+	for (loc_idx = 0 ; (loc_idx < STK_MAX_ADDED_CALLBACKS) && (AddedCBF[loc_idx] != NULL_PTR) ; loc_idx++)
+	{
+		AddedCBF[loc_idx]();
+	}
+}
+
+
+/*
+ * @brief   : Gets the time since the SysTick started in microseconds.
+ * @param   : None
+ * @return  : u64 - Microseconds counted by the SysTick (Never wraps around in practice).
+ * @details : The periods counted by SysTick_Handler + the counts elapsed in the current one (VAL).
+ * 				A period expired but not handled yet (Interrupts disabled or a higher priority ISR) is found
+ * 				by its pending state , so the time never goes back when the counter reloads in the middle of the read.
+ * 				No interrupt is disabled , it can be called from any ISR or runnable.
+ */
+u64 STK_GetTimeUs64(void)
+{
+	STK_TimeBase_t loc_Base;
+	u32 loc_Cycles = STK_ReadTimeBase(&loc_Base);
+
+	return loc_Base.Us + (loc_Cycles / CyclesPerUs);
+}
+
+
+/*
+ * @brief   : Gets the time since the SysTick started in milliseconds.
+ * @param   : None
+ * @return  : u32 - Milliseconds counted by the SysTick , wraps around every 2 pwr 32 ms (49.7 days).
+ * @details : Same reading of STK_GetTimeUs64 with 32 bit operations only.
+ */
+u32 STK_GetTimeMs(void)
+{
+	STK_TimeBase_t loc_Base;
+	u32 loc_Cycles = STK_ReadTimeBase(&loc_Base);
+
+	return loc_Base.Ms + ( (loc_Base.UsInMs + (loc_Cycles / CyclesPerUs)) / MICRO_TO_MILLI );
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Adds counts of the SysTick clock to the timebase.
+ * @param   : Counts - Counts elapsed (At most STK_MAX_RELOAD_VAL + 1).
+ * @return  : None
+ * @details : Called by SysTick_Handler or with the SysTick interrupt not able to run (Disabled interrupts or before
+ * 				the start) , so there is one writer at a time. The new time is written in the copy not in use.
+ */
+static void STK_AddCounts(u32 Counts)
+{
+	u32 loc_Seq = TimeBaseSeq;
+	volatile const STK_TimeBase_t *loc_Old = &TimeBase[loc_Seq & 1];
+	volatile STK_TimeBase_t *loc_New = &TimeBase[(loc_Seq + 1) & 1];
+	u32 loc_Cycles = loc_Old->Cycles + (Counts * CyclesPerCount);
+	u32 loc_CyclesPerUs = CyclesPerUs;
+	u32 loc_Us = loc_Cycles / loc_CyclesPerUs;
+	u32 loc_UsInMs = loc_Old->UsInMs + loc_Us;
+
+	loc_New->Us = loc_Old->Us + loc_Us;
+	loc_New->Ms = loc_Old->Ms + (loc_UsInMs / MICRO_TO_MILLI);
+	loc_New->UsInMs = loc_UsInMs % MICRO_TO_MILLI;
+	loc_New->Cycles = loc_Cycles % loc_CyclesPerUs;
+
+	TimeBaseSeq = loc_Seq + 1;
+}
+
+
+/*
+ * @brief   : Adds the counts elapsed in the current period to the timebase before the period or the clock is changed.
+ * @param   : None
+ * @return  : None
+ * @details : Called before STK_VAL is cleared. A period which expired meanwhile is added at its length
+ * 				& its handler is told not to add it again. The counts elapsed between the read of VAL & its clear
+ * 				(A few cycles) are lost.
+ */
+static void STK_AccountPeriod(void)
+{
+	u32 loc_Val = STK->STK_VAL;
+	u32 loc_Load = STK->STK_LOAD;
+
+	if ( ((*SCB_ICSR) & ICSR_PENDSTSET_MASK) && (WrapAccounted == 0) )
+	{
+		/* Expired & not handled yet --> the whole period , then the counts of the new one */
+		loc_Val = STK->STK_VAL;
+		STK_AddCounts(loc_Load + N_COUNT);
+		WrapAccounted = 1;
+	}
+
+	/* VAL = 0 --> Cleared , the period didn't start yet */
+	if (loc_Val != 0)
+	{
+		STK_AddCounts(loc_Load - loc_Val);
+	}
+}
+
+
+/*
+ * @brief   : Takes a consistent copy of the timebase & the cycles elapsed since it.
+ * @param   : Base - Pointer to store the copy of the timebase in it.
+ * @return  : u32 - Processor cycles elapsed since the copied time (Including a period expired & not handled yet).
+ * @details : Read again if the timebase was updated meanwhile (The SysTick handler preempted the reader).
+ * 				VAL is read again after the pending state is found , so it belongs to the new period.
+ */
+static u32 STK_ReadTimeBase(STK_TimeBase_t *Base)
+{
+	u32 loc_Seq;
+	u32 loc_Load;
+	u32 loc_Val;
+	u32 loc_Counts;
+
+	do
+	{
+		loc_Seq = TimeBaseSeq;
+		*Base = TimeBase[loc_Seq & 1];
+		loc_Load = STK->STK_LOAD;
+		loc_Val = STK->STK_VAL;
+		loc_Counts = 0;
+
+		if ( ((*SCB_ICSR) & ICSR_PENDSTSET_MASK) && (WrapAccounted == 0) )
+		{
+			loc_Val = STK->STK_VAL;
+			loc_Counts = loc_Load + N_COUNT;
+		}
+	} while (loc_Seq != TimeBaseSeq);
+
+	/* VAL = 0 --> Cleared , the period didn't start yet (Or its last count , counted at the reload) */
+	if (loc_Val != 0)
+	{
+		loc_Counts += loc_Load - loc_Val;
+	}
+
+	return Base->Cycles + (loc_Counts * CyclesPerCount);
+}
+
+
+/*
+ * @brief   : Loads the counts of a period in microseconds.
+ * @param   : TimeUs - The time interval in microseconds.
+ * @return  : enumError_t - Indicating Status of the operation (WrongInput --> Out of the 24 bit RELOAD at the current clock).
+ * @details : Counts = HCLK / Clock source divider * TimeUs / 10 pwr 6 calculated in 64 bits , then RELOAD = Counts - 1.
+ * 				The period is kept to be loaded again by STK_ClockChanged.
+ */
+static enumError_t STK_LoadPeriodUs(u32 TimeUs)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u64 loc_Counts = ( (u64)RCC_Get_HclkFreq() * TimeUs ) / ( (u64)MICRO_TO_SEC * CyclesPerCount );
+
+	if ( (loc_Counts < (RELOAD_MIN_TIME + N_COUNT)) || (loc_Counts > ((u64)RELOAD_MAX_TIME + N_COUNT)) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		/* Set the reload value and clear the current value in VAL register to avoid and corruption from old values */
+		STK_AccountPeriod();
+		STK->STK_LOAD = (u32)loc_Counts - N_COUNT;
+		STK->STK_VAL = 0;
+
+		PeriodUs = TimeUs;
+		PeriodOutOfRange = 0;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : Adapts the SysTick to a new HCLK (Clock change callback of RCC).
+ * @param   : None
+ * @return  : None
+ * @details : The counts elapsed are added to the timebase at the old clock (Those between the switch & this
+ * 				callback are counted at the old clock too) , then the period set in time units is loaded again.
+ * 				The interrupts are disabled as the timebase has one writer at a time , their state is restored
+ * 				as RCC may be called with them already disabled.
+ * 				A period out of the RELOAD at the new clock keeps the old RELOAD (Wrong period) & is reported
+ * 				by STK_GetStatus till a period is loaded successfully.
+ */
+static void STK_ClockChanged(void)
+{
+	u32 loc_Primask = Core_SaveDisableIRQ();
+
+	STK_AccountPeriod();
+	STK->STK_VAL = 0;
+	STK_UpdateCyclesPerUs();
+
+	if ( (PeriodUs != 0) && (STK_LoadPeriodUs(PeriodUs) != Ok) )
+	{
+		PeriodOutOfRange = 1;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+}
+
+
+/*
+ * @brief   : Reads the processor cycles of one microsecond from HCLK.
+ * @param   : None
+ * @return  : None
+ * @details : The timebase needs HCLK of a whole number of MHz (At least 1 MHz).
+ */
+static void STK_UpdateCyclesPerUs(void)
+{
+	u32 loc_CyclesPerUs = RCC_Get_HclkFreq() / MICRO_TO_SEC;
+
+	CyclesPerUs = (loc_CyclesPerUs == 0) ? 1 : loc_CyclesPerUs;
 }
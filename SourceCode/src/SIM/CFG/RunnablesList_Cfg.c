@@ -0,0 +1,43 @@
+/*
+ ============================================================================
+ Name        : RunnablesList_Cfg.c
+ Author      : Farah Mohey
+ Description : Source File for Configuring the Runnables List of the Scheduler simulator (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/******************************* Includes **************************************/
+
+#include "CFG/RunnablesList_Cfg.h"
+#include "SIM/Sched_Sim.h"
+
+/*************************** Functions Prototypes *******************************/
+
+SCHED_SIM_DEFINE_RUNNABLE(SWITCH)
+SCHED_SIM_DEFINE_RUNNABLE(app1)
+SCHED_SIM_DEFINE_RUNNABLE(app2)
+SCHED_SIM_DEFINE_RUNNABLE(Traffic)
+SCHED_SIM_DEFINE_RUNNABLE(LCD)
+
+/***************************** Implementation **********************************/
+
+/*Global array to set RunnablesList configuration , same runnables of the example in src/CFG/RunnablesList_Cfg.c */
+const  Runnable_t RunnableList[_MaxRunnables] =
+{
+    [SWITCH] = {.Name = "SwitchRunnable", .PeriodicityMs = 5,  .cb = SCHED_SIM_RUNNABLE(SWITCH) , .DelayTimeMs = 0 , .WcetUs = 32},
+    [app1] = {.Name = "ToggleLed1", .PeriodicityMs = 20,  .cb = SCHED_SIM_RUNNABLE(app1) , .DelayTimeMs = 1000 , .WcetUs = 10},
+    [app2] = {.Name = "ToggleLed2", .PeriodicityMs = 10,  .cb = SCHED_SIM_RUNNABLE(app2) , .DelayTimeMs = 0 , .WcetUs = 10},
+    [Traffic] = {.Name = "TrafficLight", .PeriodicityMs = 2000,  .cb = SCHED_SIM_RUNNABLE(Traffic) , .DelayTimeMs = 0 , .WcetUs = 75},
+    [LCD] = {.Name = "LCD", .PeriodicityMs = 2,  .cb = SCHED_SIM_RUNNABLE(LCD) , .DelayTimeMs = 0 , .WcetUs = 375},
+};
+
+/*Execution time of each runnable in processor cycles (CLK_FREQUENCY_MHZ) */
+const SchedSim_Cost_t SchedSimCostList[_MaxRunnables] =
+{
+    [SWITCH] = {.MinCycles = 300 , .MaxCycles = 500},
+    [app1] = {.MinCycles = 150 , .MaxCycles = 150},
+    [app2] = {.MinCycles = 150 , .MaxCycles = 150},
+    [Traffic] = {.MinCycles = 800 , .MaxCycles = 1200},
+    [LCD] = {.MinCycles = 2000 , .MaxCycles = 6000},
+};
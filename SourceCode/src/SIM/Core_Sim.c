@@ -0,0 +1,245 @@
+/*
+ ============================================================================
+ Name        : Core_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the emulated Cortex-M4 core instructions & exceptions (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "SIM/Core_Sim.h"
+#include "SIM/STK_Sim.h"
+
+/***************************** Definitions *************************************/
+
+#define CORE_SIM_THREAD		0
+#define CORE_SIM_PENDSV		14
+#define CORE_SIM_SYSTICK	15
+
+#define CORE_SIM_WORD_BITS	32
+
+/****************************** Variables **************************************/
+
+/* Emulated PRIMASK , 1 --> The exceptions are masked */
+static u8 Sim_Primask;
+
+/* Pending exceptions , bit N --> Exception number N */
+static u32 Sim_Pending;
+
+/* Exception being executed (IPSR) */
+static u32 Sim_Active = CORE_SIM_THREAD;
+
+/* Handlers of the exceptions , PendSV is implemented by the scheduler in preemptive mode only */
+extern void SysTick_Handler(void);
+extern void PendSV_Handler(void) __attribute__((weak));
+
+
+/************************ Static Function Prototypes ***************************/
+
+static void Core_Sim_ServicePending(void);
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Disables all the configurable interrupts (Sets the emulated PRIMASK).
+ */
+void Core_DisableIRQ(void)
+{
+	Sim_Primask = 1;
+}
+
+
+/*
+ * @brief   : Enables all the configurable interrupts & executes the pending exceptions.
+ */
+void Core_EnableIRQ(void)
+{
+	Sim_Primask = 0;
+	Core_Sim_ServicePending();
+}
+
+
+/*
+ * @brief   : Disables all the configurable interrupts & returns the previous emulated PRIMASK.
+ */
+u32 Core_SaveDisableIRQ(void)
+{
+	u32 loc_Primask = Sim_Primask;
+
+	Sim_Primask = 1;
+
+	return loc_Primask;
+}
+
+
+/*
+ * @brief   : Restores the emulated PRIMASK saved by Core_SaveDisableIRQ , executes the pending exceptions if enabled.
+ */
+void Core_RestoreIRQ(u32 Primask)
+{
+	Sim_Primask = (u8)Primask;
+
+	if (Sim_Primask == 0)
+	{
+		Core_Sim_ServicePending();
+	}
+}
+
+
+/*
+ * @brief   : Advances the virtual clock till an exception is pending , then executes it if not masked.
+ * @details : Like the real WFI a pending exception wakes the core up even if PRIMASK is set.
+ */
+void Core_WaitForInterrupt(void)
+{
+	if (Sim_Pending == 0)
+	{
+		STK_Sim_RunToExpiry();
+	}
+
+	Core_Sim_ServicePending();
+}
+
+
+/*
+ * @brief   : Same as Core_WaitForInterrupt , the idle loop has nothing to do till the next interrupt.
+ */
+void Core_Idle(void)
+{
+	Core_WaitForInterrupt();
+}
+
+
+/*
+ * @brief   : Data Memory Barrier , a full fence of the host (Code using it may be tested from several host threads).
+ */
+void Core_DataMemoryBarrier(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+/*
+ * @brief   : Data Synchronization Barrier , the host accesses are already completed in order.
+ */
+void Core_DataSyncBarrier(void)
+{
+}
+
+
+/*
+ * @brief   : Gets the number of the exception being executed.
+ * @return  : u32 - 0 --> Thread mode , Otherwise the exception number (14 --> PendSV , 15 --> SysTick).
+ */
+u32 Core_GetActiveException(void)
+{
+	return Sim_Active;
+}
+
+
+/*
+ * @brief   : Counts the leading zero bits of the low 32 bits of a word.
+ * @param   : Value - Word to be scanned.
+ * @return  : u32 - Position of the most significant set bit counted from bit 31 (32 --> Value is zero).
+ * @details : u32 may be wider than 32 bits on the host , so only the low 32 bits are scanned like the target.
+ */
+u32 Core_CountLeadingZeros(u32 Value)
+{
+	u32 Ret_Zeros = CORE_SIM_WORD_BITS;
+	unsigned int loc_Word = (unsigned int)(Value & 0xFFFFFFFFUL);
+
+	if (loc_Word)
+	{
+		Ret_Zeros = (u32)__builtin_clz(loc_Word);
+	}
+
+	return Ret_Zeros;
+}
+
+
+/*
+ * @brief   : Sets bits of a word shared with the exceptions.
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be set.
+ */
+void Core_AtomicSetBits(volatile u32 *Word , u32 Mask)
+{
+	*Word |= Mask;
+}
+
+
+/*
+ * @brief   : Clears bits of a word shared with the exceptions.
+ * @param   : Word - Pointer to the shared word.
+ * @param   : Mask - Bits to be cleared.
+ */
+void Core_AtomicClearBits(volatile u32 *Word , u32 Mask)
+{
+	*Word &= ~Mask;
+}
+
+
+/*
+ * @brief   : Sets an exception pending & executes it if allowed.
+ * @param   : Exception - Exception number (14 --> PendSV , 15 --> SysTick).
+ * @return  : None
+ */
+void Core_Sim_SetPending(u32 Exception)
+{
+	Sim_Pending |= (1UL << Exception);
+	Core_Sim_ServicePending();
+}
+
+
+/*
+ * @brief   : Clears the pending state of an exception.
+ * @param   : Exception - Exception number (14 --> PendSV , 15 --> SysTick).
+ * @return  : None
+ */
+void Core_Sim_ClearPending(u32 Exception)
+{
+	Sim_Pending &= ~(1UL << Exception);
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Executes the pending exceptions allowed to preempt the active one.
+ * @param   : None
+ * @return  : None
+ * @details : SysTick preempts PendSV & the thread , PendSV preempts the thread only (The priorities required
+ *            by the scheduler). A handler returning with an exception pending tail-chains to it.
+ */
+static void Core_Sim_ServicePending(void)
+{
+	u32 loc_Preempted = Sim_Active;
+	u8 loc_Continue = 1;
+
+	while ( (Sim_Primask == 0) && (loc_Continue) )
+	{
+		if ( (Sim_Pending & (1UL << CORE_SIM_SYSTICK)) && (loc_Preempted != CORE_SIM_SYSTICK) )
+		{
+			Core_Sim_ClearPending(CORE_SIM_SYSTICK);
+			Sim_Active = CORE_SIM_SYSTICK;
+			SysTick_Handler();
+			Sim_Active = loc_Preempted;
+		}
+		else if ( (Sim_Pending & (1UL << CORE_SIM_PENDSV)) && (loc_Preempted == CORE_SIM_THREAD) )
+		{
+			Core_Sim_ClearPending(CORE_SIM_PENDSV);
+			if (PendSV_Handler)
+			{
+				Sim_Active = CORE_SIM_PENDSV;
+				PendSV_Handler();
+				Sim_Active = loc_Preempted;
+			}
+		}
+		else
+		{
+			loc_Continue = 0;
+		}
+	}
+}
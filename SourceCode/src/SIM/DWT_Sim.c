@@ -0,0 +1,83 @@
+/*
+ ============================================================================
+ Name        : DWT_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the simulated DWT cycle counter (Host build)
+ Created	 : 22-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "SIM/DWT_Sim.h"
+
+/***************************** Definitions *************************************/
+
+/* Value of CYCCNT after DWT_Init , tools/Sched_Sim.sh sets it just below 2^32 for the SCHED_SIM_WRAP runs */
+#ifndef DWT_SIM_START_CYCLES
+#define DWT_SIM_START_CYCLES	0
+#endif
+
+#if defined(DWT_SIM_HOST_CYCLES) && !defined(__x86_64__) && !defined(__i386__)
+#error "DWT_SIM_HOST_CYCLES reads the time stamp counter of an x86 host"
+#endif
+
+/****************************** Variables **************************************/
+
+/* Simulated CYCCNT register */
+static volatile u32 Sim_CycleCount;
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Enables the cycle counter of the DWT.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Restarts the simulated counter from DWT_SIM_START_CYCLES.
+ */
+enumError_t DWT_Init(void)
+{
+	Sim_CycleCount = DWT_SIM_START_CYCLES;
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Starts the cycle counter of the DWT if it isn't already counting.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The simulated counter always counts , it's left unchanged.
+ */
+enumError_t DWT_Start(void)
+{
+	return Ok;
+}
+
+
+/*
+ * @brief   : Gets the current value of the cycle counter (CYCCNT).
+ * @param   : None
+ * @return  : u32 - Simulated cycles counted since DWT_Init , wrapping around at 2^32 like CYCCNT.
+ * @details : Built with DWT_SIM_HOST_CYCLES (tools/Sched_Bench.py) it returns the time stamp counter of the host
+ * 				instead , so the profiling of the scheduler measures the host cycles of its own code.
+ */
+u32 DWT_GetCycleCount(void)
+{
+#ifdef DWT_SIM_HOST_CYCLES
+	return (u32)__builtin_ia32_rdtsc();
+#else
+	return Sim_CycleCount;
+#endif
+}
+
+
+/*
+ * @brief   : Advances the simulated cycle counter.
+ * @param   : Cycles - Number of cycles to add to the counter.
+ * @return  : None
+ */
+void DWT_Sim_AddCycles(u32 Cycles)
+{
+	Sim_CycleCount += Cycles;
+}
@@ -0,0 +1,292 @@
+/*
+ ============================================================================
+ Name        : GPIO_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the test of the batch GPIO initialization on fake registers (Host build)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include <stdio.h>
+#include <string.h>
+#include "MCAL/GPIO.h"
+#include "HAL/LED.h"
+#include "HAL/SWITCH.h"
+#include "CFG/GPIO_Image_Cfg.h"
+
+/*
+ * The real src/MCAL/GPIO.c runs on GPIO_Sim_Registers , the ports of GPIO.h (CORE_SIM) are at their offsets in it.
+ *   1. Random batches of pins (Repeated pins , every port , mood , speed & alternate function) on random registers :
+ *      GPIO_InitPins must leave the same registers as GPIO_InitPin called for every pin in order.
+ *   2. A batch with an invalid entry is refused without writing any register.
+ *   3. GPIO_InitImages of the generated images (CFG/GPIO_Image_Cfg.h) must leave the same registers as
+ *      GPIO_InitPins of LEDS[] & SWITCHES[] configured like LED_Init & SWITCH_Init.
+ */
+
+/***************************** Definitions *************************************/
+
+#define GPIO_SIM_BATCHES			2000
+#define GPIO_SIM_MAX_PINS			40
+#define GPIO_SIM_PORTS				6
+#define GPIO_SIM_MOODS				19
+#define GPIO_SIM_SPEEDS				4
+#define GPIO_SIM_ALT_FUNCS			16
+#define GPIO_SIM_PINS				16
+
+#define GPIO_SIM_PORT_SPAN			0x400
+
+/* Index of the registers in a port (u32 of the host) */
+#define GPIO_SIM_MODER				0
+#define GPIO_SIM_OSPEEDR			2
+#define GPIO_SIM_PUPDR				3
+#define GPIO_SIM_REGISTERS			10
+
+/* Constants of the pseudo random generator (Numerical Recipes LCG) */
+#define GPIO_SIM_LCG_MUL			1664525UL
+#define GPIO_SIM_LCG_ADD			1013904223UL
+#define GPIO_SIM_LCG_MASK			0xFFFFFFFFUL
+
+/****************************** Variables **************************************/
+
+u8 GPIO_Sim_Registers[GPIO_SIM_REGISTERS_SIZE] __attribute__((aligned(sizeof(u32))));
+
+/* Registers before the test & after the reference initialization */
+static u8 SimBefore[GPIO_SIM_REGISTERS_SIZE];
+static u8 SimExpected[GPIO_SIM_REGISTERS_SIZE];
+
+static u32 Sim_RandState = 1;
+
+extern const LED_Cfg_t LEDS[_Led_Num];
+extern const SWITCH_Cfg_t SWITCHES[_Switch_Num];
+
+static void *const SimPorts[GPIO_SIM_PORTS] = { GPIO_PORTA , GPIO_PORTB , GPIO_PORTC , GPIO_PORTD , GPIO_PORTE , GPIO_PORTH };
+
+static const u32 SimMoods[GPIO_SIM_MOODS] =
+{
+	GPIO_INPUT_FL , GPIO_INPUT_PU , GPIO_INPUT_PD ,
+	GPIO_OUTPUT_PP , GPIO_OUTPUT_PP_PU , GPIO_OUTPUT_PP_PD , GPIO_OUTPUT_OD , GPIO_OUTPUT_OD_PU , GPIO_OUTPUT_OD_PD ,
+	GPIO_ANALOG ,
+	GPIO_AF_PP , GPIO_AF_PP_PU , GPIO_AF_PP_PD , GPIO_AF_OD , GPIO_AF_OD_PU , GPIO_AF_OD_PD ,
+	GPIO_AF_PP , GPIO_AF_OD , GPIO_OUTPUT_PP		/* More AF pins to exercise AFRL & AFRH */
+};
+
+
+/************************ Static Function Prototypes ***************************/
+
+static u32  GPIOSim_Random(void);
+static u32  GPIOSim_TestBatches(void);
+static u32  GPIOSim_TestInvalid(void);
+static u32  GPIOSim_TestImages(void);
+static void GPIOSim_ResetRegisters(void);
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Runs the tests.
+ * @param   : None
+ * @return  : int - 0 --> Every test passed , 1 --> Failure.
+ */
+int main(void)
+{
+	u32 loc_Failed = 0;
+
+	loc_Failed |= GPIOSim_TestBatches();
+	loc_Failed |= GPIOSim_TestInvalid();
+	loc_Failed |= GPIOSim_TestImages();
+
+	return (int)loc_Failed;
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Compares GPIO_InitPins to GPIO_InitPin on random batches.
+ * @param   : None
+ * @return  : u32 - 0 --> Passed , 1 --> Failed.
+ */
+static u32 GPIOSim_TestBatches(void)
+{
+	GPIO_Config_t loc_Configs[GPIO_SIM_MAX_PINS];
+	u32 loc_Batch;
+	u32 loc_Count;
+	u32 loc_idx;
+	u32 loc_Errors = 0;
+
+	for (loc_Batch = 0 ; loc_Batch < GPIO_SIM_BATCHES ; loc_Batch++)
+	{
+		loc_Count = 1 + (GPIOSim_Random() % GPIO_SIM_MAX_PINS);
+		for (loc_idx = 0 ; loc_idx < loc_Count ; loc_idx++)
+		{
+			loc_Configs[loc_idx].Port = SimPorts[GPIOSim_Random() % GPIO_SIM_PORTS];
+			loc_Configs[loc_idx].Pin = GPIOSim_Random() % GPIO_SIM_PINS;
+			loc_Configs[loc_idx].Speed = GPIOSim_Random() % GPIO_SIM_SPEEDS;
+			loc_Configs[loc_idx].Mood = SimMoods[GPIOSim_Random() % GPIO_SIM_MOODS];
+			loc_Configs[loc_idx].AltFunc = GPIOSim_Random() % GPIO_SIM_ALT_FUNCS;
+		}
+
+		for (loc_idx = 0 ; loc_idx < GPIO_SIM_REGISTERS_SIZE ; loc_idx++)
+		{
+			GPIO_Sim_Registers[loc_idx] = (u8)GPIOSim_Random();
+		}
+		memcpy(SimBefore , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE);
+
+		for (loc_idx = 0 ; loc_idx < loc_Count ; loc_idx++)
+		{
+			if (GPIO_InitPin(&loc_Configs[loc_idx]) != Ok)
+			{
+				loc_Errors++;
+			}
+		}
+		memcpy(SimExpected , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE);
+		memcpy(GPIO_Sim_Registers , SimBefore , GPIO_SIM_REGISTERS_SIZE);
+
+		if ( (GPIO_InitPins(loc_Configs , loc_Count) != Ok) ||
+			 (memcmp(SimExpected , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE) != 0) )
+		{
+			loc_Errors++;
+		}
+	}
+
+	printf("GPIO_InitPins == GPIO_InitPin per pin    : %s (%d random batches , %u errors)\n" ,
+			(loc_Errors == 0) ? "Ok" : "FAILED" , GPIO_SIM_BATCHES , loc_Errors);
+
+	return (loc_Errors == 0) ? 0 : 1;
+}
+
+
+/*
+ * @brief   : Checks a batch with an invalid entry is refused before writing any register.
+ * @param   : None
+ * @return  : u32 - 0 --> Passed , 1 --> Failed.
+ */
+static u32 GPIOSim_TestInvalid(void)
+{
+	GPIO_Config_t loc_Configs[2] =
+	{
+		{ .Port = GPIO_PORTA , .Pin = GPIO_PIN1 , .Speed = GPIO_LOW_SPEED , .Mood = GPIO_OUTPUT_PP , .AltFunc = GPIO_AF0 },
+		{ .Port = GPIO_PORTA , .Pin = GPIO_PIN2 , .Speed = GPIO_LOW_SPEED , .Mood = GPIO_AF_PP , .AltFunc = GPIO_AF15 + 1 }
+	};
+	u32 loc_Ret;
+
+	memset(GPIO_Sim_Registers , 0xA5 , GPIO_SIM_REGISTERS_SIZE);
+	memcpy(SimBefore , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE);
+
+	loc_Ret = GPIO_InitPins(loc_Configs , 2);
+	loc_Ret = ( (loc_Ret != Ok) && (memcmp(SimBefore , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE) == 0) &&
+				(GPIO_InitPins(NULL_PTR , 1) == NullPointer) ) ? 0 : 1;
+
+	printf("Invalid batch refused , nothing written   : %s\n" , (loc_Ret == 0) ? "Ok" : "FAILED");
+
+	return loc_Ret;
+}
+
+
+/*
+ * @brief   : Compares the generated images to GPIO_InitPins of LEDS[] & SWITCHES[].
+ * @param   : None
+ * @return  : u32 - 0 --> Passed , 1 --> Failed.
+ * @details : BSRR isn't a stored register , the image one is compared to the levels of the LEDs.
+ */
+static u32 GPIOSim_TestImages(void)
+{
+	GPIO_Config_t loc_Configs[_Led_Num + _Switch_Num];
+	u32 loc_Levels[GPIO_SIM_REGISTERS_SIZE / GPIO_SIM_PORT_SPAN] = {0};
+	u32 loc_Count = 0;
+	u32 loc_Errors = 0;
+	u32 loc_PortIdx;
+	u32 loc_idx;
+	volatile u32 *loc_Port;
+
+	/*Same configurations as LED_Init & SWITCH_Init*/
+	for (loc_idx = 0 ; loc_idx < _Led_Num ; loc_idx++ , loc_Count++)
+	{
+		loc_Configs[loc_Count].Port = LEDS[loc_idx].Port;
+		loc_Configs[loc_Count].Pin = LEDS[loc_idx].Pin;
+		loc_Configs[loc_Count].Speed = GPIO_HIGH_SPEED;
+		loc_Configs[loc_Count].Mood = GPIO_OUTPUT_PP;
+		loc_Configs[loc_Count].AltFunc = GPIO_AF0;
+
+		loc_PortIdx = (u32)((u8 *)LEDS[loc_idx].Port - GPIO_Sim_Registers) / GPIO_SIM_PORT_SPAN;
+		loc_Levels[loc_PortIdx] |= (LEDS[loc_idx].Connection ^ LEDS[loc_idx].Status) << LEDS[loc_idx].Pin;
+	}
+	for (loc_idx = 0 ; loc_idx < _Switch_Num ; loc_idx++ , loc_Count++)
+	{
+		loc_Configs[loc_Count].Port = SWITCHES[loc_idx].Port;
+		loc_Configs[loc_Count].Pin = SWITCHES[loc_idx].Pin;
+		loc_Configs[loc_Count].Speed = GPIO_LOW_SPEED;
+		loc_Configs[loc_Count].Mood = SWITCHES[loc_idx].Connection;
+		loc_Configs[loc_Count].AltFunc = GPIO_AF0;
+	}
+
+	GPIOSim_ResetRegisters();
+	if (GPIO_InitPins(loc_Configs , loc_Count) != Ok)
+	{
+		loc_Errors++;
+	}
+	memcpy(SimExpected , GPIO_Sim_Registers , GPIO_SIM_REGISTERS_SIZE);
+
+	GPIOSim_ResetRegisters();
+	if (GPIO_InitImages(GPIO_Images , GPIO_IMAGE_PORTS) != Ok)
+	{
+		loc_Errors++;
+	}
+
+	for (loc_PortIdx = 0 ; loc_PortIdx < (GPIO_SIM_REGISTERS_SIZE / GPIO_SIM_PORT_SPAN) ; loc_PortIdx++)
+	{
+		loc_Port = (volatile u32 *)&GPIO_Sim_Registers[loc_PortIdx * GPIO_SIM_PORT_SPAN];
+		for (loc_idx = 0 ; loc_idx < GPIO_SIM_REGISTERS ; loc_idx++)
+		{
+			if (loc_idx == GPIO_BSRR_INDEX)
+			{
+				loc_Errors += (loc_Port[loc_idx] != loc_Levels[loc_PortIdx]);
+			}
+			else
+			{
+				loc_Errors += (loc_Port[loc_idx] != ((u32 *)&SimExpected[loc_PortIdx * GPIO_SIM_PORT_SPAN])[loc_idx]);
+			}
+		}
+	}
+
+	printf("GPIO_InitImages == LEDS[] & SWITCHES[]    : %s (%d ports , %u errors)\n" ,
+			(loc_Errors == 0) ? "Ok" : "FAILED" , GPIO_IMAGE_PORTS , loc_Errors);
+
+	return (loc_Errors == 0) ? 0 : 1;
+}
+
+
+/*
+ * @brief   : Sets the registers to the reset values of the STM32F401 (RM0368).
+ * @param   : None
+ * @return  : None
+ */
+static void GPIOSim_ResetRegisters(void)
+{
+	volatile u32 *loc_PortA = (volatile u32 *)GPIO_PORTA;
+	volatile u32 *loc_PortB = (volatile u32 *)GPIO_PORTB;
+
+	memset(GPIO_Sim_Registers , 0 , GPIO_SIM_REGISTERS_SIZE);
+
+	loc_PortA[GPIO_SIM_MODER] = 0xA8000000;
+	loc_PortA[GPIO_SIM_OSPEEDR] = 0x0C000000;
+	loc_PortA[GPIO_SIM_PUPDR] = 0x64000000;
+	loc_PortB[GPIO_SIM_MODER] = 0x00000280;
+	loc_PortB[GPIO_SIM_OSPEEDR] = 0x000000C0;
+	loc_PortB[GPIO_SIM_PUPDR] = 0x00000100;
+}
+
+
+/*
+ * @brief   : Gets the next pseudo random number.
+ * @param   : None
+ * @return  : u32 - The number , the same sequence at every run.
+ */
+static u32 GPIOSim_Random(void)
+{
+	Sim_RandState = (Sim_RandState * GPIO_SIM_LCG_MUL + GPIO_SIM_LCG_ADD) & GPIO_SIM_LCG_MASK;
+
+	/* The high bits of the LCG are the random ones */
+	return Sim_RandState >> 16;
+}
@@ -0,0 +1,89 @@
+/*
+ ============================================================================
+ Name        : IWDG_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the simulated independent watchdog (Host build)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "SIM/IWDG_Sim.h"
+#include "SIM/STK_Sim.h"
+
+/***************************** Definitions *************************************/
+
+#define MILLI_PER_SEC           1000
+
+/****************************** Variables **************************************/
+
+static IWDG_Sim_Stats_t Sim_Stats;
+
+/* Virtual clock at the last refresh */
+static u64 Sim_LastRefresh;
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Starts the independent watchdog.
+ * @param   : TimeoutMs - Time without refresh after which the microcontroller is reset (1 to IWDG_MAX_TIMEOUT_MS).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t IWDG_Init(u32 TimeoutMs)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if ( (TimeoutMs == 0) || (TimeoutMs > IWDG_MAX_TIMEOUT_MS) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Sim_Stats.TimeoutCycles = ((u64)CLK_FREQUENCY_MHZ * TimeoutMs) / MILLI_PER_SEC;
+		Sim_LastRefresh = STK_Sim_GetCycles();
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : Reloads the counter of the watchdog.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Measures the gap since the previous refresh.
+ */
+enumError_t IWDG_Refresh(void)
+{
+	u64 loc_Now = STK_Sim_GetCycles();
+	u64 loc_Gap = loc_Now - Sim_LastRefresh;
+
+	if (Sim_Stats.TimeoutCycles)
+	{
+		if (loc_Gap > Sim_Stats.MaxGapCycles)
+		{
+			Sim_Stats.MaxGapCycles = loc_Gap;
+		}
+		if (loc_Gap > Sim_Stats.TimeoutCycles)
+		{
+			Sim_Stats.Expiries++;
+		}
+	}
+	Sim_LastRefresh = loc_Now;
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Gets the refresh statistics of the simulated watchdog.
+ * @param   : Stats - Pointer to store the statistics in it.
+ * @return  : None
+ */
+void IWDG_Sim_GetStats(IWDG_Sim_Stats_t *Stats)
+{
+	*Stats = Sim_Stats;
+}
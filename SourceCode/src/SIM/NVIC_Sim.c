@@ -0,0 +1,99 @@
+/*
+ ============================================================================
+ Name        : NVIC_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the simulated NVIC functions used by the Scheduler (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "MCAL/NVIC.h"
+#include "SIM/Core_Sim.h"
+#include "SIM/STK_Sim.h"
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief    : Set the Priority Grouping
+ * @param[in]: GroupPriority - Group priority value (PRIORITY_GROUP0 ... PRIORITY_GROUP5)
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : There is no AIRCR on the host , the grouping is only checked.
+ */
+enumError_t NVIC_SetPriorityGrouping(u32 GroupPriority)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if ( (GroupPriority != PRIORITY_GROUP0) && (GroupPriority != PRIORITY_GROUP1) && (GroupPriority != PRIORITY_GROUP2)
+		&& (GroupPriority != PRIORITY_GROUP3) && (GroupPriority != PRIORITY_GROUP5) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set System Exception Priority
+ * @param[in]: SysException - NVIC_SYS_PENDSV or NVIC_SYS_SYSTICK
+ * @param[in]: PreemptGroup - Preemption priority group
+ * @param[in]: SubpriorityGroup - Subpriority group
+ * @param[in]: GroupPriority - Group priority value (PRIORITY_GROUP0 ... PRIORITY_GROUP5)
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Core_Sim.c executes the exceptions by the order the scheduler requires (SysTick > PendSV) ,
+ * 				so the priorities are only checked.
+ */
+enumError_t NVIC_SetSystemPriority(u8 SysException, u8 PreemptGroup ,u8 SubpriorityGroup ,u32 GroupPriority )
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	(void)PreemptGroup;
+	(void)SubpriorityGroup;
+	(void)GroupPriority;
+
+	if ( (SysException != NVIC_SYS_PENDSV) && (SysException != NVIC_SYS_SYSTICK) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Set PendSV Pending
+ * @param[in]: None
+ * @return   : enumError_t - Indicating Status of the operation
+ * @details  : Its handler runs at once if no higher priority exception is active & PRIMASK is clear.
+ */
+enumError_t NVIC_SetPending_PendSV(void)
+{
+	Core_Sim_SetPending(NVIC_SYS_PENDSV);
+
+	return Ok;
+}
+
+
+/*
+ * @brief    : Resets the microcontroller
+ * @param[in]: None
+ * @return   : None - It never returns
+ * @details  : The simulation can't restart the application , it stops with a failure status.
+ */
+void NVIC_SystemReset(void)
+{
+	printf("System reset requested at %llu cycles , simulation stopped\n" , STK_Sim_GetCycles());
+	exit(EXIT_FAILURE);
+}
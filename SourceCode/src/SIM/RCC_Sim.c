@@ -0,0 +1,49 @@
+/*
+ ============================================================================
+ Name        : RCC_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the simulated RCC clock functions used by the Scheduler (Host build)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "MCAL/RCC.h"
+#include "CFG/STK_Cfg.h"
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief    : Get System Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , SYSCLK in Hz.
+ * @details  : The virtual clock of STK_Sim.c runs at CLK_FREQUENCY_MHZ & never changes.
+ */
+u32 RCC_Get_SysClkFreq(void)
+{
+	return CLK_FREQUENCY_MHZ;
+}
+
+
+/*
+ * @brief    : Get AHB Clock Frequency.
+ * @param	 : void
+ * @return   : u32 , HCLK in Hz.
+ */
+u32 RCC_Get_HclkFreq(void)
+{
+	return CLK_FREQUENCY_MHZ;
+}
+
+
+/*
+ * @brief    : Add a callback notified when HCLK changes.
+ * @param	 : CallBack , Function called after the clock changes.
+ * @return   : enumError_t , Error status indicating success or failure.
+ * @details  : The simulated clock never changes , so the callback is only checked.
+ */
+enumError_t RCC_AddClockChangeCallBack(RCC_CBF_t CallBack)
+{
+	return (CallBack == NULL_PTR) ? NullPointer : Ok;
+}
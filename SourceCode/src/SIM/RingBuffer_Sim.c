@@ -0,0 +1,364 @@
+/*
+ ============================================================================
+ Name        : RingBuffer_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the two thread stress test & throughput of the ring buffer (Host build)
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "Service/RingBuffer.h"
+#include "LIB/CortexM4_Core.h"
+
+/*
+ * The producer & the consumer of src/Service/RingBuffer.c run in two host threads (Core_DataMemoryBarrier is a full
+ * fence of the host) on a small buffer , so it's full & empty all the time & the indices wrap around the storage
+ * continuously. Every element carries its sequence number & its complement : The consumer checks it receives
+ * 0 , 1 , 2 ... (No element lost , duplicated or reordered) & no element half written.
+ *
+ * Each API pair is measured alone (Elements per second of the host) , then all of them are mixed at random.
+ */
+
+/***************************** Definitions *************************************/
+
+/* Elements passed per API pair when not given in the command line (Millions) */
+#define RINGBUFFER_SIM_DEFAULT_MILLIONS		4
+
+#define RINGBUFFER_SIM_CAPACITY				64
+#define RINGBUFFER_SIM_BATCH				16
+#define RINGBUFFER_SIM_MILLION				1000000
+
+#define RINGBUFFER_SIM_NS_PER_SEC			1000000000
+
+/* API pairs of the producer & the consumer */
+#define RINGBUFFER_SIM_SINGLE				0		/* RingBuffer_Push & RingBuffer_Pop */
+#define RINGBUFFER_SIM_BATCHES				1		/* RingBuffer_PushBatch & RingBuffer_PopBatch */
+#define RINGBUFFER_SIM_IN_PLACE				2		/* RingBuffer_Reserve / Commit & RingBuffer_Peek / Release */
+#define RINGBUFFER_SIM_MIXED				3		/* One of the above at random for every operation */
+#define RINGBUFFER_SIM_MODES				4
+
+/* Constants of the pseudo random generator of the mixed mode (Numerical Recipes LCG) */
+#define RINGBUFFER_SIM_LCG_MUL				1664525UL
+#define RINGBUFFER_SIM_LCG_ADD				1013904223UL
+#define RINGBUFFER_SIM_LCG_MASK				0xFFFFFFFFUL
+
+/***************************** Types Declaration *******************************/
+
+/*Element of the test */
+typedef struct
+{
+	u32 Seq;		/* Sequence number */
+	u32 Check;		/* ~Seq , a half written element doesn't match it */
+} RingBufferSim_Element_t;
+
+/*One run of the test */
+typedef struct
+{
+	u32 Mode;		/* RINGBUFFER_SIM_SINGLE ... */
+	u32 Count;		/* Elements to be passed */
+	u32 Received;	/* Elements popped by the consumer , Count when none is lost or duplicated */
+	u32 Errors;		/* Elements received out of sequence or torn (Consumer) */
+	u32 FirstBad;	/* Sequence number expected at the first error */
+	volatile u32 ProducerDone;	/* The consumer stops when the buffer is empty after it (Lost elements) */
+	volatile u32 ConsumerDone;	/* The producer stops when it's set before its end (Duplicated elements) */
+} RingBufferSim_Run_t;
+
+/****************************** Variables **************************************/
+
+RINGBUFFER_DEFINE(SimRing , RingBufferSim_Element_t , RINGBUFFER_SIM_CAPACITY);
+
+static const char *const SimModeNames[RINGBUFFER_SIM_MODES] =
+{
+	"Push / Pop",
+	"PushBatch / PopBatch",
+	"Reserve / Commit , Peek / Release",
+	"Mixed"
+};
+
+
+/************************ Static Function Prototypes ***************************/
+
+static void *RingBufferSim_Producer(void *Arg);
+static void *RingBufferSim_Consumer(void *Arg);
+static u32  RingBufferSim_Random(u32 *State);
+static u32  RingBufferSim_Check(RingBufferSim_Run_t *Run , const RingBufferSim_Element_t *Elements , u32 Count , u32 Expected);
+static f64  RingBufferSim_Now(void);
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Runs the test of every API pair.
+ * @param   : argv[1] - Elements passed per API pair in millions (Default RINGBUFFER_SIM_DEFAULT_MILLIONS).
+ * @return  : int - 0 --> Every element received once & in order , 1 --> Failure.
+ */
+int main(int argc , char *argv[])
+{
+	RingBufferSim_Run_t loc_Run;
+	pthread_t loc_Producer;
+	pthread_t loc_Consumer;
+	u32 loc_Millions = RINGBUFFER_SIM_DEFAULT_MILLIONS;
+	u32 loc_Failed = 0;
+	f64 loc_Start;
+	f64 loc_Seconds;
+
+	if (argc > 1)
+	{
+		loc_Millions = (u32)strtoul(argv[1] , NULL_PTR , 10);
+	}
+
+	printf("Ring buffer of %d elements of %d bytes , %u M elements per API pair\n\n" ,
+			RINGBUFFER_SIM_CAPACITY , (int)sizeof(RingBufferSim_Element_t) , loc_Millions);
+
+	for (loc_Run.Mode = RINGBUFFER_SIM_SINGLE ; loc_Run.Mode < RINGBUFFER_SIM_MODES ; loc_Run.Mode++)
+	{
+		loc_Run.Count = loc_Millions * RINGBUFFER_SIM_MILLION;
+		loc_Run.Received = 0;
+		loc_Run.Errors = 0;
+		loc_Run.FirstBad = 0;
+		loc_Run.ProducerDone = 0;
+		loc_Run.ConsumerDone = 0;
+		RingBuffer_Init(&SimRing , SimRing_Storage , sizeof(RingBufferSim_Element_t) , RINGBUFFER_SIM_CAPACITY);
+
+		loc_Start = RingBufferSim_Now();
+		if ( (pthread_create(&loc_Consumer , NULL_PTR , RingBufferSim_Consumer , &loc_Run) != 0) ||
+			 (pthread_create(&loc_Producer , NULL_PTR , RingBufferSim_Producer , &loc_Run) != 0) )
+		{
+			printf("Can't create the threads\n");
+			return 1;
+		}
+		pthread_join(loc_Producer , NULL_PTR);
+		pthread_join(loc_Consumer , NULL_PTR);
+		loc_Seconds = RingBufferSim_Now() - loc_Start;
+
+		if ( (loc_Run.Errors != 0) || (loc_Run.Received != loc_Run.Count) || (RingBuffer_GetCount(&SimRing) != 0) )
+		{
+			printf("%-34s : FAILED , %u of %u received , %u bad (First expected %u) , %u left\n" ,
+					SimModeNames[loc_Run.Mode] , loc_Run.Received , loc_Run.Count , loc_Run.Errors , loc_Run.FirstBad ,
+					RingBuffer_GetCount(&SimRing));
+			loc_Failed = 1;
+		}
+		else
+		{
+			printf("%-34s : Ok , %7.2f M elements/s\n" , SimModeNames[loc_Run.Mode] ,
+					(f64)loc_Run.Count / (loc_Seconds * RINGBUFFER_SIM_MILLION));
+		}
+	}
+
+	return (int)loc_Failed;
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Pushes the sequence 0 , 1 , 2 ... Count - 1 by the API pair of the run.
+ * @param   : Arg - Pointer to the run (RingBufferSim_Run_t).
+ * @return  : void * - NULL_PTR.
+ * @details : A full buffer is retried till the consumer frees it (Giving the CPU to it on a single core host) ,
+ * 				stops early if the consumer already received Count elements.
+ */
+static void *RingBufferSim_Producer(void *Arg)
+{
+	RingBufferSim_Run_t *loc_Run = (RingBufferSim_Run_t *)Arg;
+	RingBufferSim_Element_t loc_Batch[RINGBUFFER_SIM_BATCH];
+	RingBufferSim_Element_t *loc_Region;
+	u32 loc_RandState = 1;
+	u32 loc_Seq = 0;
+	u32 loc_Count;
+	u32 loc_Done;
+	u32 loc_idx;
+
+	while ( (loc_Seq < loc_Run->Count) && (loc_Run->ConsumerDone == 0) )
+	{
+		loc_Count = RINGBUFFER_SIM_BATCH;
+		if (loc_Count > (loc_Run->Count - loc_Seq))
+		{
+			loc_Count = loc_Run->Count - loc_Seq;
+		}
+		loc_Done = 0;
+
+		switch ( (loc_Run->Mode == RINGBUFFER_SIM_MIXED) ? (RingBufferSim_Random(&loc_RandState) % RINGBUFFER_SIM_MIXED) : loc_Run->Mode )
+		{
+		case RINGBUFFER_SIM_SINGLE:
+			loc_Batch[0].Seq = loc_Seq;
+			loc_Batch[0].Check = ~loc_Seq;
+			if (RingBuffer_Push(&SimRing , &loc_Batch[0]) == Ok)
+			{
+				loc_Done = 1;
+			}
+			break;
+
+		case RINGBUFFER_SIM_BATCHES:
+			for (loc_idx = 0 ; loc_idx < loc_Count ; loc_idx++)
+			{
+				loc_Batch[loc_idx].Seq = loc_Seq + loc_idx;
+				loc_Batch[loc_idx].Check = ~(loc_Seq + loc_idx);
+			}
+			RingBuffer_PushBatch(&SimRing , loc_Batch , loc_Count , &loc_Done);
+			break;
+
+		default:
+			if (RingBuffer_Reserve(&SimRing , (void **)&loc_Region , &loc_Done) == Ok)
+			{
+				if (loc_Done > loc_Count)
+				{
+					loc_Done = loc_Count;
+				}
+				for (loc_idx = 0 ; loc_idx < loc_Done ; loc_idx++)
+				{
+					loc_Region[loc_idx].Seq = loc_Seq + loc_idx;
+					loc_Region[loc_idx].Check = ~(loc_Seq + loc_idx);
+				}
+				RingBuffer_Commit(&SimRing , loc_Done);
+			}
+			break;
+		}
+
+		if (loc_Done == 0)
+		{
+			sched_yield();
+		}
+		loc_Seq += loc_Done;
+	}
+
+	Core_DataMemoryBarrier();
+	loc_Run->ProducerDone = 1;
+
+	return NULL_PTR;
+}
+
+
+/*
+ * @brief   : Pops Count elements by the API pair of the run & checks their sequence.
+ * @param   : Arg - Pointer to the run (RingBufferSim_Run_t).
+ * @return  : void * - NULL_PTR.
+ * @details : An empty buffer is retried till the producer fills it (Giving the CPU to it on a single core host) ,
+ * 				the errors are counted in the run. Stops after Count elements or when the buffer is empty
+ * 				after the end of the producer.
+ */
+static void *RingBufferSim_Consumer(void *Arg)
+{
+	RingBufferSim_Run_t *loc_Run = (RingBufferSim_Run_t *)Arg;
+	RingBufferSim_Element_t loc_Batch[RINGBUFFER_SIM_BATCH];
+	const RingBufferSim_Element_t *loc_Region;
+	u32 loc_RandState = 2;
+	u32 loc_Expected = 0;
+	u32 loc_ProducerDone = 0;
+	u32 loc_Done = 1;
+
+	while ( (loc_Expected < loc_Run->Count) && ((loc_Done != 0) || (loc_ProducerDone == 0)) )
+	{
+		/* Read before trying so an empty buffer after it means nothing more will come */
+		loc_ProducerDone = loc_Run->ProducerDone;
+		Core_DataMemoryBarrier();
+		loc_Done = 0;
+
+		switch ( (loc_Run->Mode == RINGBUFFER_SIM_MIXED) ? (RingBufferSim_Random(&loc_RandState) % RINGBUFFER_SIM_MIXED) : loc_Run->Mode )
+		{
+		case RINGBUFFER_SIM_SINGLE:
+			if (RingBuffer_Pop(&SimRing , &loc_Batch[0]) == Ok)
+			{
+				loc_Done = RingBufferSim_Check(loc_Run , loc_Batch , 1 , loc_Expected);
+			}
+			break;
+
+		case RINGBUFFER_SIM_BATCHES:
+			if (RingBuffer_PopBatch(&SimRing , loc_Batch , RINGBUFFER_SIM_BATCH , &loc_Done) == Ok)
+			{
+				loc_Done = RingBufferSim_Check(loc_Run , loc_Batch , loc_Done , loc_Expected);
+			}
+			break;
+
+		default:
+			if (RingBuffer_Peek(&SimRing , (const void **)&loc_Region , &loc_Done) == Ok)
+			{
+				loc_Done = RingBufferSim_Check(loc_Run , loc_Region , loc_Done , loc_Expected);
+				RingBuffer_Release(&SimRing , loc_Done);
+			}
+			break;
+		}
+
+		if (loc_Done == 0)
+		{
+			sched_yield();
+		}
+		loc_Expected += loc_Done;
+	}
+
+	loc_Run->Received = loc_Expected;
+	Core_DataMemoryBarrier();
+	loc_Run->ConsumerDone = 1;
+
+	return NULL_PTR;
+}
+
+
+/*
+ * @brief   : Checks received elements against the expected sequence.
+ * @param   : Run - Pointer to the run counting the errors.
+ * @param   : Elements - Received elements.
+ * @param   : Count - Number of elements.
+ * @param   : Expected - Sequence number expected for the first element.
+ * @return  : u32 - Count , the consumer moves on by the received elements even when they are wrong.
+ */
+static u32 RingBufferSim_Check(RingBufferSim_Run_t *Run , const RingBufferSim_Element_t *Elements , u32 Count , u32 Expected)
+{
+	u32 loc_idx;
+
+	for (loc_idx = 0 ; loc_idx < Count ; loc_idx++)
+	{
+		if ( (Elements[loc_idx].Seq != (Expected + loc_idx)) || (Elements[loc_idx].Check != ~(Expected + loc_idx)) )
+		{
+			if (Run->Errors == 0)
+			{
+				Run->FirstBad = Expected + loc_idx;
+			}
+			Run->Errors++;
+		}
+	}
+
+	return Count;
+}
+
+
+/*
+ * @brief   : Gets the next pseudo random number.
+ * @param   : State - State of the generator of the calling thread.
+ * @return  : u32 - The number , the same sequence at every run.
+ */
+static u32 RingBufferSim_Random(u32 *State)
+{
+	*State = (*State * RINGBUFFER_SIM_LCG_MUL + RINGBUFFER_SIM_LCG_ADD) & RINGBUFFER_SIM_LCG_MASK;
+
+	/* The high bits of the LCG are the random ones */
+	return *State >> 16;
+}
+
+
+/*
+ * @brief   : Gets the wall clock time of the host.
+ * @return  : f64 - Seconds of CLOCK_MONOTONIC (clock() would add the time of both threads).
+ */
+static f64 RingBufferSim_Now(void)
+{
+	struct timespec loc_Time;
+
+	clock_gettime(CLOCK_MONOTONIC , &loc_Time);
+
+	return (f64)loc_Time.tv_sec + ((f64)loc_Time.tv_nsec / RINGBUFFER_SIM_NS_PER_SEC);
+}
+
+
+/*
+ * @brief   : Referenced by the emulated core (Core_Sim.c) , no PendSV in this test.
+ */
+void PendSV_Handler(void)
+{
+}
@@ -0,0 +1,491 @@
+/*
+ ============================================================================
+ Name        : STK_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the simulated SysTick on a virtual clock (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include "SIM/STK_Sim.h"
+#include "SIM/Core_Sim.h"
+#include "SIM/DWT_Sim.h"
+
+/***************************** Definitions *************************************/
+
+#define STK_SIM_SYSTICK_EXCEPTION	15
+
+#define STK_START_STOP_MASK     BIT0_MASK		/*Bit0 = 1*/
+#define STK_TICKINT_MASK        BIT1_MASK		/*Bit1 = 1*/
+#define STK_MODE_CLR_MASK       0xFFFFFFF9		/*Bit1 = 0 , Bit2= 0*/
+#define CLK_SRC_MASK            BIT2_MASK		/*Bit2 = 1 */
+
+/*Range of SYSTICK 0-->24 , 2 pwr 24 = 16 million */
+#define RELOAD_MIN_TIME     BIT0_MASK		/*Bit0 = 1*/
+#define RELOAD_MAX_TIME     0x00FFFFFF		/*from bit 0- 24 =1 */
+
+#define MICRO_TO_MILLI     1000
+#define MICRO_TO_SEC       1000000
+#define N_COUNT            1
+
+/*Prescaler of the AHB/8 clock source */
+#define STK_SIM_AHB_DIV_8	8
+
+/*Processor cycles of one microsecond */
+#define STK_SIM_CYCLES_PER_US	(CLK_FREQUENCY_MHZ / MICRO_TO_SEC)
+
+/****************************** Variables **************************************/
+
+/* Simulated registers of the SysTick */
+static u32 Sim_Ctrl;
+static u32 Sim_Load;
+static u32 Sim_Val;
+static u8  Sim_CountFlag;
+
+/* Virtual clock in processor cycles & the cycles not yet counted by the AHB/8 prescaler */
+static u64 Sim_Cycles;
+static u32 Sim_PrescalerCycles;
+
+/* Processor cycles while the SysTick counts (The timebase of STK_GetTimeUs64) */
+static u64 Sim_TimeCycles;
+
+/* End of the simulation */
+static u64 Sim_EndCycles;
+static STK_Sim_EndCBF_t Sim_EndCBF = NULL_PTR;
+
+/* Callback function pointer for SysTick interrupt */
+static STK_CBF_t APP_CBF = NULL_PTR ;
+
+/* Callbacks added by STK_AddCallBack , executed after APP_CBF */
+static STK_CBF_t AddedCBF[STK_MAX_ADDED_CALLBACKS];
+
+
+/************************ Static Function Prototypes ***************************/
+
+static u32  STK_Sim_GetDivider(void);
+static void STK_Sim_Count(u32 Counts);
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Starts the SysTick timer.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_Start(void)
+{
+	Sim_Ctrl |= STK_START_STOP_MASK;
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Stops the SysTick timer.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_Stop(void)
+{
+	Sim_Ctrl &= ~(STK_START_STOP_MASK);
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Sets the configuration of the SysTick timer.
+ * @param   : Mode - The mode to configure the SysTick timer.
+ * @param	: Mode can be --> STK_AHB_8_DIS_INT ,  STK_AHB_DIS_INT
+ * 							  STK_AHB_8_ENB_INT ,  STK_AHB_ENB_INT
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_SetConfig(u32 Mode)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if ( (Mode !=STK_AHB_8_ENB_INT ) && (Mode != STK_AHB_8_DIS_INT ) && (Mode != STK_AHB_DIS_INT) && (Mode != STK_AHB_ENB_INT) )
+	{
+		Ret_ErrorStatus = WrongInput ;
+	}
+	else
+	{
+		Sim_Ctrl = (Sim_Ctrl & STK_MODE_CLR_MASK) | Mode;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : Sets the time interval for the SysTick timer.
+ * @param   : TimeMs - The time interval in milliseconds.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_SetTimeMs(u32 TimeMs)
+{
+	u32 loc_Clk = CLK_FREQUENCY_MHZ / STK_Sim_GetDivider();
+
+	return STK_SetReloadVal( ( (loc_Clk / MICRO_TO_MILLI) * TimeMs ) - N_COUNT );
+}
+
+
+/*
+ * @brief   : Sets the time interval for the SysTick timer in microseconds.
+ * @param   : TimeUs - The time interval in microseconds.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_SetTimeUs(u32 TimeUs)
+{
+	u64 loc_Counts = ( (u64)(CLK_FREQUENCY_MHZ / STK_Sim_GetDivider()) * TimeUs ) / MICRO_TO_SEC;
+
+	return (loc_Counts > ((u64)RELOAD_MAX_TIME + N_COUNT)) ? WrongInput : STK_SetReloadVal((u32)loc_Counts - N_COUNT);
+}
+
+
+/*
+ * @brief   : Sets the RELOAD value of the SysTick timer directly in timer counts.
+ * @param   : ReloadVal - Number of counts of the period - 1 (from 1 to STK_MAX_RELOAD_VAL).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : The current value & COUNTFLAG are cleared so the new period starts counting immediately.
+ */
+enumError_t STK_SetReloadVal(u32 ReloadVal)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (ReloadVal < RELOAD_MIN_TIME || ReloadVal > RELOAD_MAX_TIME)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Sim_Load = ReloadVal;
+		Sim_Val = 0;
+		Sim_CountFlag = 0;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : Get Value of LOAD Register - Counts of the current period - 1.
+ * @param   : *Reload_Val - Pointer to store in it the value.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_GET_ReloadVal(u32 *Reload_Val)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Reload_Val == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Reload_Val = Sim_Load;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus ;
+}
+
+
+/*
+ * @brief   : Get Value of COUNTFLAG - If the timer counted to 0 since the last time it was read.
+ * @param   : *Count_Flag - Pointer to store in it the flag (1 --> counted to 0 , 0 --> not).
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ * @details : Reading the flag clears it.
+ */
+enumError_t STK_GET_CountFlag(u8 *Count_Flag)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Count_Flag == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Count_Flag = Sim_CountFlag;
+		Sim_CountFlag = 0;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus ;
+}
+
+
+/*
+ * @brief   : Gets whether the SysTick runs the period set in time units.
+ * @param   : None
+ * @return  : enumError_t - Ok , the simulated HCLK never changes.
+ */
+enumError_t STK_GetStatus(void)
+{
+	return Ok;
+}
+
+
+/*
+ * @brief   : Clears the pending state of the SysTick exception.
+ * @param   : None
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_ClearPending(void)
+{
+	Core_Sim_ClearPending(STK_SIM_SYSTICK_EXCEPTION);
+
+	return Ok;
+}
+
+
+/*
+ * @brief   : Get Current Value of VAL Register - Remaining Time for SYSTICK.
+ * @param   : *Curr_Val - Pointer to store in it the value.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_GET_CurrentVal(u32 *Curr_Val)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Curr_Val == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Curr_Val = Sim_Val;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus ;
+}
+
+
+/*
+ * @brief   : Sets the callback function for the SysTick timer interrupt.
+ * @param   : CallBack - Pointer to the callback function.
+ * @return  : enumError_t - Indicating Status of the operation if Success or Failure
+ */
+enumError_t STK_SetCallBack(STK_CBF_t CallBack)
+{
+	u32 Ret_ErrorStatus = Nok;
+
+	if (CallBack == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		APP_CBF = CallBack;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+/*
+ * @brief   : Adds a callback function for the SysTick timer interrupt.
+ * @param   : CallBack - Pointer to the callback function.
+ * @return  : enumError_t - Indicating Status of the operation (Nok --> STK_MAX_ADDED_CALLBACKS already added).
+ */
+enumError_t STK_AddCallBack(STK_CBF_t CallBack)
+{
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_idx;
+
+	if (CallBack == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		for (loc_idx = 0 ; (loc_idx < STK_MAX_ADDED_CALLBACKS) && (Ret_ErrorStatus != Ok) ; loc_idx++)
+		{
+			if ( (AddedCBF[loc_idx] == NULL_PTR) || (AddedCBF[loc_idx] == CallBack) )
+			{
+				AddedCBF[loc_idx] = CallBack;
+				Ret_ErrorStatus = Ok;
+			}
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief   : SysTick interrupt handler.
+ * @param   : None
+ * @return  : None
+ * @details : Executed by Core_Sim.c when the simulated SysTick exception is pending & allowed.
+ */
+void SysTick_Handler(void)
+{
+	u32 loc_idx;
+
+	if (APP_CBF)
+	{
+		APP_CBF();
+	}
+
+	for (loc_idx = 0 ; (loc_idx < STK_MAX_ADDED_CALLBACKS) && (AddedCBF[loc_idx] != NULL_PTR) ; loc_idx++)
+	{
+		AddedCBF[loc_idx]();
+	}
+}
+
+
+/*
+ * @brief   : Gets the time since the SysTick started in microseconds.
+ * @param   : None
+ * @return  : u64 - Microseconds of the virtual clock counted while the SysTick runs.
+ * @details : Exact on the virtual clock (The target loses a few counts at every change of the period).
+ */
+u64 STK_GetTimeUs64(void)
+{
+	return Sim_TimeCycles / STK_SIM_CYCLES_PER_US;
+}
+
+
+/*
+ * @brief   : Gets the time since the SysTick started in milliseconds.
+ * @param   : None
+ * @return  : u32 - Milliseconds counted by the SysTick , wraps around every 2 pwr 32 ms.
+ */
+u32 STK_GetTimeMs(void)
+{
+	return (u32)(STK_GetTimeUs64() / MICRO_TO_MILLI);
+}
+
+
+/*
+ * @brief   : Sets the end of the simulation.
+ * @param   : EndCycles - Virtual clock cycles to be simulated.
+ * @param   : EndCallBack - Function called when the virtual clock reaches EndCycles.
+ * @return  : None
+ */
+void STK_Sim_SetEnd(u64 EndCycles , STK_Sim_EndCBF_t EndCallBack)
+{
+	Sim_EndCycles = EndCycles;
+	Sim_EndCBF = EndCallBack;
+}
+
+
+/*
+ * @brief   : Advances the virtual clock.
+ * @param   : Cycles - Processor clock cycles consumed by the code.
+ * @return  : None
+ */
+void STK_Sim_AddCycles(u32 Cycles)
+{
+	u32 loc_Divider = STK_Sim_GetDivider();
+	u32 loc_Counts;
+
+	if ( (Sim_EndCBF) && (Sim_Cycles >= Sim_EndCycles) )
+	{
+		Sim_EndCBF();
+	}
+
+	Sim_Cycles += Cycles;
+	DWT_Sim_AddCycles(Cycles);
+
+	Sim_PrescalerCycles += Cycles;
+	loc_Counts = Sim_PrescalerCycles / loc_Divider;
+	Sim_PrescalerCycles -= loc_Counts * loc_Divider;
+
+	if (Sim_Ctrl & STK_START_STOP_MASK)
+	{
+		Sim_TimeCycles += Cycles;
+		STK_Sim_Count(loc_Counts);
+	}
+}
+
+
+/*
+ * @brief   : Advances the virtual clock to the next time the SysTick reaches zero.
+ * @param   : None
+ * @return  : None
+ */
+void STK_Sim_RunToExpiry(void)
+{
+	u32 loc_Counts;
+
+	if ( ( (Sim_Ctrl & STK_START_STOP_MASK) == 0 ) || ( (Sim_Ctrl & STK_TICKINT_MASK) == 0 ) )
+	{
+		/* Nothing can wake the core up */
+		Sim_Cycles = Sim_EndCycles;
+		STK_Sim_AddCycles(0);
+	}
+	else
+	{
+		/* From zero the counter reloads first --> LOAD + 1 counts */
+		loc_Counts = (Sim_Val == 0) ? (Sim_Load + N_COUNT) : Sim_Val;
+		STK_Sim_AddCycles( (loc_Counts * STK_Sim_GetDivider()) - Sim_PrescalerCycles );
+	}
+}
+
+
+/*
+ * @brief   : Gets the virtual clock.
+ * @param   : None
+ * @return  : u64 - Processor clock cycles simulated since the start.
+ */
+u64 STK_Sim_GetCycles(void)
+{
+	return Sim_Cycles;
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Gets the processor cycles of one count of the SysTick.
+ * @param   : None
+ * @return  : u32 - 1 for the processor clock (AHB) , 8 for AHB/8.
+ */
+static u32 STK_Sim_GetDivider(void)
+{
+	return (Sim_Ctrl & CLK_SRC_MASK) ? 1 : STK_SIM_AHB_DIV_8;
+}
+
+
+/*
+ * @brief   : Counts the SysTick down.
+ * @param   : Counts - Number of counts of the SysTick clock.
+ * @return  : None
+ * @details : At every zero COUNTFLAG is set & the exception is set pending. A handler executed at once
+ *            may advance the clock itself , the rest of the counts continue from the updated registers.
+ */
+static void STK_Sim_Count(u32 Counts)
+{
+	u32 loc_ToZero;
+
+	while (Counts)
+	{
+		/* From zero the counter reloads first --> LOAD + 1 counts to the next zero */
+		loc_ToZero = (Sim_Val == 0) ? (Sim_Load + N_COUNT) : Sim_Val;
+
+		if (Counts < loc_ToZero)
+		{
+			Sim_Val = (Sim_Val == 0) ? (Sim_Load - (Counts - N_COUNT)) : (Sim_Val - Counts);
+			Counts = 0;
+		}
+		else
+		{
+			Counts -= loc_ToZero;
+			Sim_Val = 0;
+			Sim_CountFlag = 1;
+			if (Sim_Ctrl & STK_TICKINT_MASK)
+			{
+				Core_Sim_SetPending(STK_SIM_SYSTICK_EXCEPTION);
+			}
+		}
+	}
+}
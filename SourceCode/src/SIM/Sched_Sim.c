@@ -0,0 +1,424 @@
+/*
+ ============================================================================
+ Name        : Sched_Sim.c
+ Author      : Farah Mohey
+ Description : Source file for the virtual time simulator of the Scheduler (Host build)
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/******************************** Includes **************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <time.h>
+#include "SIM/Sched_Sim.h"
+#include "SIM/STK_Sim.h"
+#include "SIM/IWDG_Sim.h"
+
+/***************************** Definitions *************************************/
+
+/* Simulated time when not given in the command line */
+#define SCHED_SIM_DEFAULT_HOURS		24
+
+#define SCHED_SIM_SEC_PER_HOUR		3600
+#define SCHED_SIM_MS_PER_SEC		1000
+#define SCHED_SIM_US_PER_SEC		1000000
+#define SCHED_SIM_PERCENT			100
+
+/* Processor cycles of one scheduler tick */
+#define SCHED_SIM_TICK_CYCLES		( ((u64)CLK_FREQUENCY_MHZ * TICK_TIME_US) / SCHED_SIM_US_PER_SEC )
+
+/* Configured time of a runnable in microseconds */
+#define SCHED_SIM_TIME_US(MS , US)	( ((u64)(MS) * (SCHED_SIM_US_PER_SEC / SCHED_SIM_MS_PER_SEC)) + (US) )
+
+/* Load histogram : 10 % per bucket , the last one counts the ticks loaded 100 % or more */
+#define SCHED_SIM_LOAD_STEP			10
+#define SCHED_SIM_LOAD_BUCKETS		11
+
+/* Constants of the pseudo random generator of the execution times (Numerical Recipes LCG) */
+#define SCHED_SIM_LCG_MUL			1664525UL
+#define SCHED_SIM_LCG_ADD			1013904223UL
+#define SCHED_SIM_LCG_MASK			0xFFFFFFFFUL
+
+/***************************** Types Declaration *******************************/
+
+/*Releases of a simulated runnable */
+typedef struct
+{
+	u64 Releases;			/* Number of executions */
+	u64 FirstCycles;		/* Virtual time of the first execution */
+	s64 LastDriftCycles;	/* Start of the last execution - (First + Releases * Period) */
+	s64 MaxDriftCycles;		/* Largest drift in absolute value */
+} SchedSim_Stats_t;
+
+/****************************** Variables **************************************/
+
+extern const Runnable_t RunnableList[_MaxRunnables];
+extern const SchedSim_Cost_t SchedSimCostList[_MaxRunnables];
+
+static SchedSim_Stats_t SimStats[_MaxRunnables];
+
+/* Tick being accounted & the cycles the runnables consumed in it */
+static u64 Sim_LoadTick;
+static u64 Sim_LoadTickCycles;
+
+/* Per-tick load */
+static u64 Sim_LoadBuckets[SCHED_SIM_LOAD_BUCKETS];
+static u64 Sim_PeakLoadCycles;
+static u64 Sim_BusyCycles;
+
+static u32 Sim_RandState = 1;
+
+/* Context of main to return to when the simulated time ends */
+static jmp_buf Sim_EndContext;
+
+
+/************************ Static Function Prototypes ***************************/
+
+static void SchedSim_End(void);
+static void SchedSim_AccountLoad(u64 Tick);
+static u32  SchedSim_GetCost(u32 RunnableIdx);
+static s64  SchedSim_CyclesToUs(s64 Cycles);
+static void SchedSim_Report(u32 Hours , f64 HostSeconds);
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+static void SchedSim_PrintSchedulability(const char *Title);
+#endif
+#if SCHED_JITTER == SCHED_ENABLE
+static void SchedSim_PrintJitter(u32 RunnableIdx , const char *Name , const Sched_JitterHistogram_t *Histogram);
+#endif
+
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief   : Runs the simulation.
+ * @param   : argv[1] - Simulated time in hours (Default SCHED_SIM_DEFAULT_HOURS).
+ * @return  : int - 0 --> Success.
+ */
+int main(int argc , char *argv[])
+{
+	static u32 loc_Hours = SCHED_SIM_DEFAULT_HOURS;	/* Kept out of the stack frame restored by longjmp */
+	clock_t loc_HostStart;
+
+	if (argc > 1)
+	{
+		loc_Hours = (u32)strtoul(argv[1] , NULL_PTR , 10);
+	}
+
+	STK_Sim_SetEnd((u64)loc_Hours * SCHED_SIM_SEC_PER_HOUR * CLK_FREQUENCY_MHZ , SchedSim_End);
+
+	loc_HostStart = clock();
+
+	if (setjmp(Sim_EndContext) == 0)
+	{
+		switch (Sched_Init())
+		{
+		case Ok:
+			break;
+		case Sched_NotSchedulable:
+			printf("Warning : Sched_Init found the runnables not schedulable\n");
+			break;
+		default:
+			printf("Warning : Sched_Init failed , some runnables are not scheduled\n");
+			break;
+		}
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+		SchedSim_PrintSchedulability("Declared WCET");
+#endif
+		Sched_Start();
+	}
+
+	SchedSim_Report(loc_Hours , (f64)(clock() - loc_HostStart) / CLOCKS_PER_SEC);
+
+	return 0;
+}
+
+
+/*
+ * @brief   : Executes a simulated runnable.
+ * @param   : RunnableIdx - Index of the runnable in RunnableList.
+ * @return  : None
+ * @details : The cycles are consumed tick by tick to account the load of each tick ,
+ * 				a runnable preempting this one accounts its own cycles.
+ */
+void SchedSim_Execute(u32 RunnableIdx)
+{
+	SchedSim_Stats_t *loc_Stats = &SimStats[RunnableIdx];
+	u64 loc_Now = STK_Sim_GetCycles();
+	u64 loc_PeriodCycles = ( SCHED_SIM_TIME_US(RunnableList[RunnableIdx].PeriodicityMs , RunnableList[RunnableIdx].PeriodicityUs)
+							* CLK_FREQUENCY_MHZ ) / SCHED_SIM_US_PER_SEC;
+	u64 loc_TickEnd;
+	u32 loc_Cost;
+	u32 loc_Part;
+	s64 loc_Drift;
+
+	if (loc_Stats->Releases == 0)
+	{
+		loc_Stats->FirstCycles = loc_Now;
+	}
+	else
+	{
+		loc_Drift = (s64)(loc_Now - (loc_Stats->FirstCycles + (loc_Stats->Releases * loc_PeriodCycles)));
+		loc_Stats->LastDriftCycles = loc_Drift;
+		if (llabs(loc_Drift) > llabs(loc_Stats->MaxDriftCycles))
+		{
+			loc_Stats->MaxDriftCycles = loc_Drift;
+		}
+	}
+	loc_Stats->Releases++;
+
+	loc_Cost = SchedSim_GetCost(RunnableIdx);
+	while (loc_Cost)
+	{
+		loc_Now = STK_Sim_GetCycles();
+		SchedSim_AccountLoad(loc_Now / SCHED_SIM_TICK_CYCLES);
+
+		/* Consume till the end of the current tick at most , the tick interrupt is raised after the part */
+		loc_TickEnd = (Sim_LoadTick + 1) * SCHED_SIM_TICK_CYCLES;
+		loc_Part = ( (loc_TickEnd - loc_Now) < loc_Cost ) ? (u32)(loc_TickEnd - loc_Now) : loc_Cost;
+
+		Sim_LoadTickCycles += loc_Part;
+		Sim_BusyCycles += loc_Part;
+		loc_Cost -= loc_Part;
+
+		STK_Sim_AddCycles(loc_Part);
+	}
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief   : Ends the simulation , called by STK_Sim.c when the simulated time is reached.
+ * @param   : None
+ * @return  : None (Returns to main).
+ */
+static void SchedSim_End(void)
+{
+	longjmp(Sim_EndContext , 1);
+}
+
+
+/*
+ * @brief   : Moves the load accounting to a tick.
+ * @param   : Tick - Index of the tick consuming the next cycles.
+ * @return  : None
+ * @details : The load of the previous tick is added to the histogram , the ticks in between had no load.
+ */
+static void SchedSim_AccountLoad(u64 Tick)
+{
+	u64 loc_Bucket;
+
+	if (Tick != Sim_LoadTick)
+	{
+		loc_Bucket = (Sim_LoadTickCycles * SCHED_SIM_PERCENT) / (SCHED_SIM_TICK_CYCLES * SCHED_SIM_LOAD_STEP);
+		if (loc_Bucket >= SCHED_SIM_LOAD_BUCKETS)
+		{
+			loc_Bucket = SCHED_SIM_LOAD_BUCKETS - 1;
+		}
+		Sim_LoadBuckets[loc_Bucket]++;
+
+		if (Sim_LoadTickCycles > Sim_PeakLoadCycles)
+		{
+			Sim_PeakLoadCycles = Sim_LoadTickCycles;
+		}
+
+		Sim_LoadBuckets[0] += Tick - Sim_LoadTick - 1;
+		Sim_LoadTick = Tick;
+		Sim_LoadTickCycles = 0;
+	}
+}
+
+
+/*
+ * @brief   : Gets the execution time of the current call of a runnable.
+ * @param   : RunnableIdx - Index of the runnable in RunnableList.
+ * @return  : u32 - Pseudo random cycles between MinCycles & MaxCycles , the same sequence at every run.
+ */
+static u32 SchedSim_GetCost(u32 RunnableIdx)
+{
+	const SchedSim_Cost_t *loc_Cost = &SchedSimCostList[RunnableIdx];
+	u32 Ret_Cycles = loc_Cost->MinCycles;
+
+	if (loc_Cost->MaxCycles > loc_Cost->MinCycles)
+	{
+		Sim_RandState = (Sim_RandState * SCHED_SIM_LCG_MUL + SCHED_SIM_LCG_ADD) & SCHED_SIM_LCG_MASK;
+		Ret_Cycles += Sim_RandState % (loc_Cost->MaxCycles - loc_Cost->MinCycles + 1);
+	}
+
+	return Ret_Cycles;
+}
+
+
+/*
+ * @brief   : Converts processor cycles to microseconds.
+ * @param   : Cycles - Number of cycles.
+ * @return  : s64 - Time in microseconds.
+ */
+static s64 SchedSim_CyclesToUs(s64 Cycles)
+{
+	return (Cycles * SCHED_SIM_MS_PER_SEC) / (s64)(CLK_FREQUENCY_MHZ / SCHED_SIM_MS_PER_SEC);
+}
+
+
+/*
+ * @brief   : Prints the results of the simulation.
+ * @param   : Hours - Simulated time in hours.
+ * @param   : HostSeconds - Host processor time spent by the simulation.
+ * @return  : None
+ * @details : Expected releases are counted from the delay by the period , drift is the start of an execution
+ * 				minus the start of the first one plus the nominal periods (Grows when the period is not a multiple of the tick).
+ */
+static void SchedSim_Report(u32 Hours , f64 HostSeconds)
+{
+	u64 loc_SimUs = (u64)Hours * SCHED_SIM_SEC_PER_HOUR * SCHED_SIM_US_PER_SEC;
+	u64 loc_Ticks = loc_SimUs / TICK_TIME_US;
+	u64 loc_PeriodUs;
+	u64 loc_DelayUs;
+	u64 loc_Expected;
+	u32 loc_Overruns;
+	u32 loc_idx;
+
+	/* Flush the load of the last ticks */
+	SchedSim_AccountLoad(loc_Ticks);
+
+	printf("Simulated %u h = %llu ticks of %d us in %.2f s of host time" , Hours , loc_Ticks , TICK_TIME_US , HostSeconds);
+	if (HostSeconds > 0)
+	{
+		printf(" (%.1f M ticks/s)" , (f64)loc_Ticks / HostSeconds / SCHED_SIM_US_PER_SEC);
+	}
+	printf("\n\n%-20s %10s %12s %12s %10s %14s %14s\n" , "Runnable" , "Period(us)" , "Releases" , "Expected" , "Overruns" , "MaxDrift(us)" , "LastDrift(us)");
+
+	for (loc_idx = 0 ; loc_idx < _MaxRunnables ; loc_idx++)
+	{
+		loc_PeriodUs = SCHED_SIM_TIME_US(RunnableList[loc_idx].PeriodicityMs , RunnableList[loc_idx].PeriodicityUs);
+		loc_DelayUs = SCHED_SIM_TIME_US(RunnableList[loc_idx].DelayTimeMs , RunnableList[loc_idx].DelayTimeUs);
+
+		loc_Expected = 0;
+		if ( (RunnableList[loc_idx].Trigger == SCHED_TRIGGER_PERIODIC) && (loc_SimUs > loc_DelayUs) )
+		{
+			loc_Expected = 1;
+			if (loc_PeriodUs)
+			{
+				loc_Expected += (loc_SimUs - loc_DelayUs - 1) / loc_PeriodUs;
+			}
+		}
+
+		loc_Overruns = 0;
+		Sched_GetOverrunCount(loc_idx , &loc_Overruns);
+
+		printf("%-20s %10llu %12llu %12llu %10u %14lld %14lld\n" ,
+				RunnableList[loc_idx].Name ? RunnableList[loc_idx].Name : "-" ,
+				loc_PeriodUs , SimStats[loc_idx].Releases , loc_Expected , loc_Overruns ,
+				SchedSim_CyclesToUs(SimStats[loc_idx].MaxDriftCycles) , SchedSim_CyclesToUs(SimStats[loc_idx].LastDriftCycles));
+	}
+
+	printf("\nPer-tick load of the runnables : Peak %.1f %% , Average %.2f %%\n" ,
+			(f64)Sim_PeakLoadCycles * SCHED_SIM_PERCENT / SCHED_SIM_TICK_CYCLES ,
+			(f64)Sim_BusyCycles * SCHED_SIM_PERCENT / ((f64)loc_Ticks * SCHED_SIM_TICK_CYCLES));
+
+	for (loc_idx = 0 ; loc_idx < SCHED_SIM_LOAD_BUCKETS ; loc_idx++)
+	{
+		if (loc_idx == SCHED_SIM_LOAD_BUCKETS - 1)
+		{
+			printf("  >= %3d %%       : %llu ticks\n" , SCHED_SIM_PERCENT , Sim_LoadBuckets[loc_idx]);
+		}
+		else
+		{
+			printf("  %3u %% - %3u %% : %llu ticks\n" , loc_idx * SCHED_SIM_LOAD_STEP , (loc_idx + 1) * SCHED_SIM_LOAD_STEP - 1 , Sim_LoadBuckets[loc_idx]);
+		}
+	}
+
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+	/* Virtual cycles of the runnables , or host cycles of the whole tick when built with DWT_SIM_HOST_CYCLES */
+	Sched_TickStats_t loc_TickStats;
+	Sched_GetTickStats(&loc_TickStats);
+	printf("\nTick cost : %u ticks , Average %u cycles , Max %u cycles\n" ,
+			loc_TickStats.Count , loc_TickStats.AvgCycles , loc_TickStats.MaxCycles);
+#endif
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+	u16 loc_Load;
+	printf("\nCPU load monitor (Last windows) :");
+	for (loc_idx = 0 ; Sched_GetCpuLoad(loc_idx , &loc_Load) == Ok ; loc_idx++)
+	{
+		printf(" %u.%u %%" , loc_Load / 10 , loc_Load % 10);
+	}
+	Sched_GetPeakCpuLoad(&loc_Load);
+	printf(" , Peak %u.%u %%\n" , loc_Load / 10 , loc_Load % 10);
+#endif
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	u32 loc_BudgetOverruns;
+	printf("\nExecutions over budget :");
+	for (loc_idx = 0 ; loc_idx < _MaxRunnables ; loc_idx++)
+	{
+		loc_BudgetOverruns = 0;
+		Sched_GetBudgetOverruns(loc_idx , &loc_BudgetOverruns);
+		printf(" %s %u ," , RunnableList[loc_idx].Name ? RunnableList[loc_idx].Name : "-" , loc_BudgetOverruns);
+	}
+	printf("\n");
+#endif
+
+#if SCHED_WATCHDOG == SCHED_ENABLE
+	IWDG_Sim_Stats_t loc_Watchdog;
+	IWDG_Sim_GetStats(&loc_Watchdog);
+	printf("\nWatchdog : Longest refresh gap %lld us of %lld us timeout , %u expiries\n" ,
+			SchedSim_CyclesToUs((s64)loc_Watchdog.MaxGapCycles) , SchedSim_CyclesToUs((s64)loc_Watchdog.TimeoutCycles) ,
+			loc_Watchdog.Expiries);
+#endif
+
+#if SCHED_JITTER == SCHED_ENABLE
+	printf("\nRelease latency (%d us per bucket , the last one counts the longer latencies)\n" , SCHED_JITTER_BUCKET_US);
+	Sched_DumpJitterHistograms(SchedSim_PrintJitter);
+#endif
+
+#if SCHED_CALIBRATION == SCHED_ENABLE
+	printf("\n");
+	SchedSim_PrintSchedulability("Measured WCET");
+#endif
+}
+
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+/*
+ * @brief   : Prints the result of the schedulability check of the runnables in use.
+ * @param   : Title - WCET taken by the check (Declared or measured in a calibration build).
+ * @return  : None
+ */
+static void SchedSim_PrintSchedulability(const char *Title)
+{
+	Sched_Schedulability_t loc_Report;
+	enumError_t loc_Status = Sched_CheckSchedulability(&loc_Report);
+
+	printf("Schedulability (%s) : Utilization %u.%u %% , Worst tick load %u.%u %% at tick %u of %u --> %s\n" , Title ,
+			loc_Report.UtilizationPerMille / 10 , loc_Report.UtilizationPerMille % 10 ,
+			loc_Report.PeakTickLoadPerMille / 10 , loc_Report.PeakTickLoadPerMille % 10 ,
+			loc_Report.PeakTick , loc_Report.HyperperiodTicks , (loc_Status == Ok) ? "Schedulable" : "Not schedulable");
+}
+#endif
+
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*
+ * @brief   : Prints the release latency histogram of a runnable , called by Sched_DumpJitterHistograms.
+ * @param   : RunnableIdx - Index of the runnable.
+ * @param   : Name - Name of the runnable.
+ * @param   : Histogram - Release latency histogram of the runnable.
+ * @return  : None
+ */
+static void SchedSim_PrintJitter(u32 RunnableIdx , const char *Name , const Sched_JitterHistogram_t *Histogram)
+{
+	u32 loc_Bucket;
+
+	printf("%-20s Max %6lld us :" , Name ? Name : "-" , SchedSim_CyclesToUs(Histogram->MaxLatencyCycles));
+	for (loc_Bucket = 0 ; loc_Bucket < SCHED_JITTER_BUCKETS ; loc_Bucket++)
+	{
+		printf(" %u" , Histogram->Counts[loc_Bucket]);
+	}
+	printf("\n");
+
+	(void)RunnableIdx;
+}
+#endif
@@ -0,0 +1,478 @@
+/*
+ ============================================================================
+ Name        : RingBuffer.c
+ Author      : Farah Mohey
+ Description : Source file for the lock-free single producer / single consumer ring buffer
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/********************************* Includes **************************************/
+#include "Service/RingBuffer.h"
+#include "LIB/CortexM4_Core.h"
+
+/***************************** Definitions *************************************/
+
+/*Word copy when the addresses & the size are multiples of a word */
+#define RINGBUFFER_WORD_MASK	(sizeof(u32) - 1)
+
+/************************ Static Function Prototypes ***************************/
+
+static void RingBuffer_Copy(u8 *Dest , const u8 *Src , u32 Size);
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief    : Initializes a ring buffer on a given storage.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Storage - Buffer of Capacity * ElementSize bytes , aligned to the elements.
+ * @param[in]: ElementSize - Size of one element in bytes.
+ * @param[in]: Capacity - Number of elements , a power of two (2 , 4 , 8 ...).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The power of two capacity turns the wrap around of the indices into a mask.
+ */
+enumError_t RingBuffer_Init(RingBuffer_t *Ring , void *Storage , u32 ElementSize , u32 Capacity)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if ( (Ring == NULL_PTR) || (Storage == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else if ( (ElementSize == 0) || (Capacity < 2) || ((Capacity & (Capacity - 1)) != 0) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		Ring->Storage = (u8 *)Storage;
+		Ring->ElementSize = ElementSize;
+		Ring->Mask = Capacity - 1;
+		Ring->Head = 0;
+		Ring->Tail = 0;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Pushes one element (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Element - Pointer to the element to be copied in.
+ * @return   : enumError_t - Ok , RingBuffer_Full (The element is dropped).
+ */
+enumError_t RingBuffer_Push(RingBuffer_t *Ring , const void *Element)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Head;
+
+	if ( (Ring == NULL_PTR) || (Element == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Head = Ring->Head;
+
+		/* Unsigned subtraction keeps the count right when the indices wrap around */
+		if ( (loc_Head - Ring->Tail) > Ring->Mask )
+		{
+			Ret_ErrorStatus = RingBuffer_Full;
+		}
+		else
+		{
+			RingBuffer_Copy(&Ring->Storage[(loc_Head & Ring->Mask) * Ring->ElementSize] , (const u8 *)Element , Ring->ElementSize);
+
+			/* The element is written before the index publishing it */
+			Core_DataMemoryBarrier();
+			Ring->Head = loc_Head + 1;
+
+			Ret_ErrorStatus = Ok;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Pops one element (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Element - Pointer to store the oldest element in it.
+ * @return   : enumError_t - Ok , RingBuffer_Empty.
+ */
+enumError_t RingBuffer_Pop(RingBuffer_t *Ring , void *Element)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Tail;
+
+	if ( (Ring == NULL_PTR) || (Element == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Tail = Ring->Tail;
+
+		if (Ring->Head == loc_Tail)
+		{
+			Ret_ErrorStatus = RingBuffer_Empty;
+		}
+		else
+		{
+			/* The element is read after the index publishing it & before its slot is given back */
+			Core_DataMemoryBarrier();
+			RingBuffer_Copy((u8 *)Element , &Ring->Storage[(loc_Tail & Ring->Mask) * Ring->ElementSize] , Ring->ElementSize);
+			Core_DataMemoryBarrier();
+			Ring->Tail = loc_Tail + 1;
+
+			Ret_ErrorStatus = Ok;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Pushes an array of elements at once (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Elements - Pointer to the elements to be copied in.
+ * @param[in]: Count - Number of elements.
+ * @param[out]: Pushed - Pointer to store the number of elements pushed (NULL_PTR --> not needed).
+ * @return   : enumError_t - Ok , RingBuffer_Full (Only the elements fitting are pushed).
+ * @details  : The elements are copied in at most two blocks (Before & after the end of the storage)
+ *             & published by one index update.
+ */
+enumError_t RingBuffer_PushBatch(RingBuffer_t *Ring , const void *Elements , u32 Count , u32 *Pushed)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Head;
+	u32 loc_Free;
+	u32 loc_First;
+	u32 loc_Offset;
+
+	if ( (Ring == NULL_PTR) || (Elements == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Head = Ring->Head;
+		loc_Free = (Ring->Mask + 1) - (loc_Head - Ring->Tail);
+
+		Ret_ErrorStatus = Ok;
+		if (Count > loc_Free)
+		{
+			Count = loc_Free;
+			Ret_ErrorStatus = RingBuffer_Full;
+		}
+
+		loc_Offset = loc_Head & Ring->Mask;
+		loc_First = (Ring->Mask + 1) - loc_Offset;
+		if (loc_First > Count)
+		{
+			loc_First = Count;
+		}
+
+		RingBuffer_Copy(&Ring->Storage[loc_Offset * Ring->ElementSize] , (const u8 *)Elements , loc_First * Ring->ElementSize);
+		RingBuffer_Copy(Ring->Storage , (const u8 *)Elements + (loc_First * Ring->ElementSize) , (Count - loc_First) * Ring->ElementSize);
+
+		Core_DataMemoryBarrier();
+		Ring->Head = loc_Head + Count;
+
+		if (Pushed != NULL_PTR)
+		{
+			*Pushed = Count;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Pops up to a number of elements at once (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Elements - Pointer to store the elements in it (Room for Count elements).
+ * @param[in]: Count - Maximum number of elements.
+ * @param[out]: Popped - Pointer to store the number of elements popped.
+ * @return   : enumError_t - Ok , RingBuffer_Empty (Nothing popped).
+ */
+enumError_t RingBuffer_PopBatch(RingBuffer_t *Ring , void *Elements , u32 Count , u32 *Popped)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Tail;
+	u32 loc_Stored;
+	u32 loc_First;
+	u32 loc_Offset;
+
+	if ( (Ring == NULL_PTR) || (Elements == NULL_PTR) || (Popped == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Tail = Ring->Tail;
+		loc_Stored = Ring->Head - loc_Tail;
+
+		if (Count > loc_Stored)
+		{
+			Count = loc_Stored;
+		}
+
+		if (Count == 0)
+		{
+			Ret_ErrorStatus = RingBuffer_Empty;
+		}
+		else
+		{
+			loc_Offset = loc_Tail & Ring->Mask;
+			loc_First = (Ring->Mask + 1) - loc_Offset;
+			if (loc_First > Count)
+			{
+				loc_First = Count;
+			}
+
+			Core_DataMemoryBarrier();
+			RingBuffer_Copy((u8 *)Elements , &Ring->Storage[loc_Offset * Ring->ElementSize] , loc_First * Ring->ElementSize);
+			RingBuffer_Copy((u8 *)Elements + (loc_First * Ring->ElementSize) , Ring->Storage , (Count - loc_First) * Ring->ElementSize);
+			Core_DataMemoryBarrier();
+			Ring->Tail = loc_Tail + Count;
+
+			Ret_ErrorStatus = Ok;
+		}
+
+		*Popped = Count;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the contiguous free elements to be written in place (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Region - Pointer to store the address of the first free element in it.
+ * @param[out]: Count - Pointer to store the number of contiguous free elements (Till the end of the storage).
+ * @return   : enumError_t - Ok , RingBuffer_Full (Count is 0).
+ * @details  : Nothing is published till RingBuffer_Commit , the free space wrapping to the start of the storage
+ *             is reserved by a second call after the commit.
+ */
+enumError_t RingBuffer_Reserve(RingBuffer_t *Ring , void **Region , u32 *Count)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Head;
+	u32 loc_Free;
+	u32 loc_Offset;
+
+	if ( (Ring == NULL_PTR) || (Region == NULL_PTR) || (Count == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Head = Ring->Head;
+		loc_Free = (Ring->Mask + 1) - (loc_Head - Ring->Tail);
+		loc_Offset = loc_Head & Ring->Mask;
+
+		/* Contiguous till the end of the storage */
+		if (loc_Free > ((Ring->Mask + 1) - loc_Offset))
+		{
+			loc_Free = (Ring->Mask + 1) - loc_Offset;
+		}
+
+		/* The consumer may still read the slots freed just now , they are written after this barrier */
+		Core_DataMemoryBarrier();
+
+		*Region = &Ring->Storage[loc_Offset * Ring->ElementSize];
+		*Count = loc_Free;
+
+		Ret_ErrorStatus = (loc_Free == 0) ? RingBuffer_Full : Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Publishes the elements written in the reserved region (Producer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Count - Number of elements written , at most the reserved count.
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> More than the free elements).
+ */
+enumError_t RingBuffer_Commit(RingBuffer_t *Ring , u32 Count)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Head;
+
+	if (Ring == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Head = Ring->Head;
+
+		if (Count > ((Ring->Mask + 1) - (loc_Head - Ring->Tail)))
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else
+		{
+			/* The elements written in place are published after this barrier */
+			Core_DataMemoryBarrier();
+			Ring->Head = loc_Head + Count;
+
+			Ret_ErrorStatus = Ok;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the contiguous elements to be read in place (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[out]: Region - Pointer to store the address of the oldest element in it.
+ * @param[out]: Count - Pointer to store the number of contiguous elements (Till the end of the storage).
+ * @return   : enumError_t - Ok , RingBuffer_Empty (Count is 0).
+ * @details  : The elements stay in the buffer till RingBuffer_Release.
+ */
+enumError_t RingBuffer_Peek(RingBuffer_t *Ring , const void **Region , u32 *Count)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Tail;
+	u32 loc_Stored;
+	u32 loc_Offset;
+
+	if ( (Ring == NULL_PTR) || (Region == NULL_PTR) || (Count == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Tail = Ring->Tail;
+		loc_Stored = Ring->Head - loc_Tail;
+		loc_Offset = loc_Tail & Ring->Mask;
+
+		/* Contiguous till the end of the storage */
+		if (loc_Stored > ((Ring->Mask + 1) - loc_Offset))
+		{
+			loc_Stored = (Ring->Mask + 1) - loc_Offset;
+		}
+
+		/* The elements are read after the index publishing them */
+		Core_DataMemoryBarrier();
+
+		*Region = &Ring->Storage[loc_Offset * Ring->ElementSize];
+		*Count = loc_Stored;
+
+		Ret_ErrorStatus = (loc_Stored == 0) ? RingBuffer_Empty : Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Frees the oldest elements read in place (Consumer).
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @param[in]: Count - Number of elements , at most the peeked count.
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> More than the stored elements).
+ */
+enumError_t RingBuffer_Release(RingBuffer_t *Ring , u32 Count)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Tail;
+
+	if (Ring == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		loc_Tail = Ring->Tail;
+
+		if (Count > (Ring->Head - loc_Tail))
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else
+		{
+			/* The elements are read before their slots are given back */
+			Core_DataMemoryBarrier();
+			Ring->Tail = loc_Tail + Count;
+
+			Ret_ErrorStatus = Ok;
+		}
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the number of stored elements.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @return   : u32 - Elements pushed & not popped yet (A snapshot , it may change at once from the other side).
+ */
+u32 RingBuffer_GetCount(const RingBuffer_t *Ring)
+{
+	return Ring->Head - Ring->Tail;
+}
+
+
+/*
+ * @brief    : Gets the number of free elements.
+ * @param[in]: Ring - Pointer to the ring buffer.
+ * @return   : u32 - Elements which can be pushed (A snapshot , it may change at once from the other side).
+ */
+u32 RingBuffer_GetFree(const RingBuffer_t *Ring)
+{
+	return (Ring->Mask + 1) - (Ring->Head - Ring->Tail);
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief    : Copies a block of bytes.
+ * @param[out]: Dest - Destination address.
+ * @param[in]: Src - Source address.
+ * @param[in]: Size - Number of bytes (0 --> nothing copied).
+ * @return   : None.
+ * @details  : Copies words when both addresses & the size are aligned to a word (e.g. u32 elements) , bytes otherwise.
+ */
+static void RingBuffer_Copy(u8 *Dest , const u8 *Src , u32 Size)
+{
+	u32 loc_idx;
+
+	if ( ( ((uptr)Dest | (uptr)Src | Size) & RINGBUFFER_WORD_MASK ) == 0 )
+	{
+		for (loc_idx = 0 ; loc_idx < Size ; loc_idx += sizeof(u32))
+		{
+			*(u32 *)&Dest[loc_idx] = *(const u32 *)&Src[loc_idx];
+		}
+	}
+	else
+	{
+		for (loc_idx = 0 ; loc_idx < Size ; loc_idx++)
+		{
+			Dest[loc_idx] = Src[loc_idx];
+		}
+	}
+}
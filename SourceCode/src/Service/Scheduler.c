@@ -9,6 +9,22 @@
 
 /********************************* Includes **************************************/
 #include "Service/Scheduler.h"
+#include "LIB/CortexM4_Core.h"
+#if (SCHED_PREEMPTIVE_MODE == SCHED_ENABLE) || (SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE)
+#include "MCAL/NVIC.h"
+#endif
+#if (SCHED_PROFILING == SCHED_ENABLE) || (SCHED_TICK_PROFILING == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+#include "MCAL/DWT.h"
+#endif
+#if SCHED_WATCHDOG == SCHED_ENABLE
+#include "MCAL/IWDG.h"
+#endif
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE) || (SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE)
+#include "MCAL/RCC.h"
+#endif
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) && (SCHED_SW_TIMERS == SCHED_ENABLE)
+#include "Service/SwTimer.h"
+#endif
 
 /***************************** Types Declaration **********************************/
 
@@ -18,23 +34,296 @@
 typedef struct
 {
 	const Runnable_t *runnable;
-	u32 RemainingTimeMs;	/*Remaining time to execute the current task it should update automatically
-	 *When the value of it reaches 0 --> this the time to execute the task
-	 *Then should reset by PeriodicityMs value*/
+	u32 ReleaseTick;	/*Absolute scheduler tick of the next release of the task
+	 *The runnables wait in the slot of this value in the timing wheel
+	 *When the scheduler tick reaches it --> this the time to execute the task
+	 *Then it is advanced by PeriodTicks & the runnable is re-inserted in the wheel*/
+	u32 PeriodTicks;	/*PeriodicityMs + PeriodicityUs converted to scheduler ticks */
+	u8  Next;			/*Index of the next runnable in the slot of the wheel (Or in the free list of the pool) */
+	u8  Prev;			/*Index of the previous runnable in the slot of the wheel to remove it directly */
+	u8  State;			/*SCHED_STATE_FREE , WAITING , EVENT , RUNNING , REMOVED or IDLE */
+	u8  EventBit;		/*Bit of an event triggered runnable in the ready bitmap of its level (SCHED_NO_EVENT --> periodic) */
+	u32 OverrunCount;	/*Number of releases executed or dropped at least one tick late */
+#if SCHED_PROFILING == SCHED_ENABLE
+	u32 ExecCount;		/*Number of executions of the callback */
+	u32 MinCycles;		/*Shortest execution of the callback in cycles */
+	u32 MaxCycles;		/*Longest execution of the callback in cycles */
+	u64 TotalCycles;	/*Sum of all the executions to get the average */
+#endif
+#if SCHED_JITTER == SCHED_ENABLE
+	Sched_JitterHistogram_t Jitter;	/*Release latency histogram */
+#endif
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	u32 BudgetTicks;	/*BudgetUs converted to scheduler ticks (0 --> not enforced) */
+	u32 BudgetOverruns;	/*Number of executions over the budget */
+#endif
 } RunnableInfo_t;
 
+/*Slots of the timing wheel of a level , one bit each in its WheelMask */
+#define SCHED_WHEEL_SLOTS		32
+
+/*Scheduling level : The background cooperative loop or the high priority runnables dispatched from PendSV */
+typedef struct
+{
+	u32 Tick;			/*Next tick to be processed by the level --> counts the ticks passed to Sched() */
+	u8  ListHead;		/*Runnable with the nearest release tick of all the slots (SCHED_NO_RUNNABLE --> none waiting) */
+	u8  Wheel[SCHED_WHEEL_SLOTS];	/*Heads of the slots of the timing wheel , a runnable waits in the slot of its
+	 *ReleaseTick modulo SCHED_WHEEL_SLOTS in a list sorted by release tick */
+	u32 WheelMask;		/*Bitmap of the slots holding runnables , bit 31 is slot 0 */
+	volatile u32 ReadyMask;	/*Ready bitmap of the event triggered runnables , set by Sched_ActivateRunnable
+	 *Bit 31 is the first event runnable so CLZ gives the next one to execute */
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	volatile u8  RunningIdx;	/*Runnable executing its callback (SCHED_NO_RUNNABLE --> none) */
+	volatile u32 BudgetLeft;	/*Ticks left to the running runnable , counted down by the SysTick (0 --> not checked) */
+#endif
+} SchedLevel_t;
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+/*Window of the CPU load monitor */
+typedef struct
+{
+	u32 LengthTicks;	/*SCHED_LOAD_WINDOWS_MS converted to scheduler ticks */
+	u32 StartTick;		/*Background tick at the start of the current window */
+	u32 StartCycles;	/*Cycle counter at the start of the current window */
+	u32 StartIdle;		/*IdleCycles at the start of the current window */
+} SchedLoadWindow_t;
+#endif
+
+
+/***************************** Definitions *************************************/
+
+/*Marks the end of a slot of the wheel or of the free list */
+#define SCHED_NO_RUNNABLE	0xFF
+
+/*Slot of the wheel of a release tick */
+#define SCHED_WHEEL_SLOT(Tick)	((Tick) & (SCHED_WHEEL_SLOTS - 1))
+
+/*Bit of a slot in WheelMask , slot N is found by CLZ --> counted from bit 31 */
+#define SCHED_WHEEL_BIT(Slot)	(0x80000000UL >> (Slot))
+
+/*First tick of the levels , the host simulator starts it just below the wrap around (SCHED_SIM_WRAP) */
+#ifndef SCHED_START_TICK
+#define SCHED_START_TICK		0
+#endif
+
+/*Initial state of a level : Empty wheel , nothing ready & nothing running */
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+#define SCHED_LEVEL_INIT		{ .Tick = SCHED_START_TICK , .ListHead = SCHED_NO_RUNNABLE , .Wheel = { [0 ... (SCHED_WHEEL_SLOTS - 1)] = SCHED_NO_RUNNABLE } , \
+								  .WheelMask = 0 , .ReadyMask = 0 , .RunningIdx = SCHED_NO_RUNNABLE , .BudgetLeft = 0 }
+#else
+#define SCHED_LEVEL_INIT		{ .Tick = SCHED_START_TICK , .ListHead = SCHED_NO_RUNNABLE , .Wheel = { [0 ... (SCHED_WHEEL_SLOTS - 1)] = SCHED_NO_RUNNABLE } , \
+								  .WheelMask = 0 , .ReadyMask = 0 }
+#endif
+
+/*Use a RELOAD value of N-1 for a period of N counts */
+#define SCHED_N_COUNT		1
+
+#define SCHED_US_PER_MS		1000UL
+#define SCHED_US_PER_SEC	1000000UL
+
+/*Processor cycles of one tick at the highest clock (The runtime values are calculated from HCLK read from RCC) */
+#define SCHED_TICK_CYCLES	(((CLK_MAX_FREQUENCY_HZ / SCHED_US_PER_MS) * TICK_TIME_US) / SCHED_US_PER_MS)
+
+#if CLK_MAX_FREQUENCY_HZ < CLK_FREQUENCY_MHZ
+#error "CLK_MAX_FREQUENCY_HZ of CFG/STK_Cfg.h is lower than the expected HCLK CLK_FREQUENCY_MHZ"
+#endif
+
+/*The generated tick must fit in the 24 bit RELOAD of the SysTick counting the processor clock at every HCLK
+ *the application switches to , so it is checked at the highest one */
+#if (TICK_TIME_US == 0) || (SCHED_TICK_CYCLES > (STK_MAX_RELOAD_VAL + SCHED_N_COUNT))
+#error "TICK_TIME_US doesn't fit in the SysTick at CLK_MAX_FREQUENCY_HZ , regenerate CFG/Sched_Tick_Cfg.h by tools/Sched_Tick.py"
+#endif
+
+/*States of a runnable slot */
+#define SCHED_STATE_FREE		0	/*Slot of the pool not used */
+#define SCHED_STATE_WAITING		1	/*Inserted in the timing wheel of its level */
+#define SCHED_STATE_RUNNING		2	/*Its callback is executing */
+#define SCHED_STATE_REMOVED		3	/*Removed while running --> Freed when the callback returns */
+#define SCHED_STATE_IDLE		4	/*Static runnable not released anymore (One shot done or removed) */
+#define SCHED_STATE_EVENT		5	/*Event triggered runnable waiting for its activation */
+
+/*EventBit of the periodic runnables */
+#define SCHED_NO_EVENT			0xFF
+
+/*Mask of an event bit in the ready bitmap , event bit N is found by CLZ --> counted from bit 31 */
+#define SCHED_EVENT_MASK(BIT)	(0x80000000UL >> (BIT))
+
+/*Total slots : The static RunnableList followed by the pool of the dynamic runnables */
+#define SCHED_MAX_RUNNABLES		(_MaxRunnables + SCHED_DYNAMIC_RUNNABLES)
+
+/*Slots 0 --> _MaxRunnables - 1 are RunnableList & the others the pool , checked against the total size so an empty
+ *RunnableList doesn't compare an unsigned index with 0 */
+#define SCHED_IS_TABLE_SLOT(Idx)	( (SCHED_MAX_RUNNABLES - (u32)(Idx)) > SCHED_DYNAMIC_RUNNABLES )
+#define SCHED_IS_POOL_SLOT(Idx)		( (SCHED_MAX_RUNNABLES - (u32)(Idx)) <= SCHED_DYNAMIC_RUNNABLES )
+
+/*Ticks to the release of a level which has no waiting runnable */
+#define SCHED_NO_RELEASE		0x7FFFFFFF
+
+/*Initial value of the shortest execution to be replaced by the first measurement */
+#define SCHED_MIN_CYCLES_INIT	0xFFFFFFFF
+
+/*The offsets are generated from RunnableList , the releases of a mode switch are taken from the tick of the switch */
+#if (SCHED_OPTIMIZED_OFFSETS == SCHED_ENABLE) && (SCHED_MODES == SCHED_ENABLE)
+#error "SCHED_OPTIMIZED_OFFSETS can't be used with SCHED_MODES , the offsets don't follow the tables of the modes"
+#endif
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+#if (SCHED_CALIBRATION == SCHED_ENABLE) && (SCHED_PROFILING != SCHED_ENABLE)
+#error "SCHED_CALIBRATION takes the measured executions of SCHED_PROFILING"
+#endif
+
+/*Utilization & tick load of a fully used CPU */
+#define SCHED_FULL_LOAD_PERMILLE	1000
+
+/*Hyperperiod longer than the 32 bits of the report */
+#define SCHED_MAX_HYPERPERIOD		0xFFFFFFFFULL
+#endif
+
 
 /****************************** Variables *************************************/
 
 extern const  Runnable_t RunnableList[_MaxRunnables];
+#if SCHED_OPTIMIZED_OFFSETS == SCHED_ENABLE
+extern const  u32 RunnableOffsetsUs[_MaxRunnables];
+#endif
+#if SCHED_MODES == SCHED_ENABLE
+extern const  Runnable_t *const SchedModeList[_MaxSchedModes];
+#endif
 static volatile u32 PendingTicks;
-static RunnableInfo_t RunnableInfoList[_MaxRunnables];
+static RunnableInfo_t RunnableInfoList[SCHED_MAX_RUNNABLES];
+
+/*Head of the list of the free slots of the pool */
+static u8 FreeListHead = SCHED_NO_RUNNABLE;
+
+/*Event bits not given to an event triggered runnable */
+static u32 FreeEventBits = 0xFFFFFFFF;
+
+/*Index of the runnable of each event bit */
+static u8 EventRunnables[SCHED_MAX_EVENT_RUNNABLES];
+
+/*Indices are stored in u8 with SCHED_NO_RUNNABLE marking the end of the lists */
+_Static_assert(SCHED_MAX_RUNNABLES < SCHED_NO_RUNNABLE , "Too many runnables , reduce SCHED_DYNAMIC_RUNNABLES");
+
+/*Background level , its runnables are executed by the loop of Sched_Start */
+static SchedLevel_t BgLevel = SCHED_LEVEL_INIT;
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+/*High priority level , its runnables are executed by PendSV_Handler preempting the background loop */
+static SchedLevel_t HpLevel = SCHED_LEVEL_INIT;
+
+/*Ticks not yet processed by the high priority level */
+static volatile u32 HpPendingTicks;
+
+/*Ticks remaining to the nearest high priority release , published by PendSV_Handler
+ *& counted down by the tick so PendSV is requested only when a high priority runnable is due */
+static volatile s32 HpTicksToRelease = SCHED_NO_RELEASE;
+#endif
+
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+/*Cycles spent in the ticks */
+static u32 TickCount;
+static u32 TickMaxCycles;
+static u64 TickTotalCycles;
+#endif
+
+#if SCHED_MODES == SCHED_ENABLE
+_Static_assert(_MaxSchedModes > 0 , "SCHED_MODES needs at least one mode in SchedModesList_t");
+
+/*Mode of the runnables in the timing wheels & the mode requested by Sched_SetMode , switched by the background loop */
+static u8 CurrentMode;
+static volatile u8 RequestedMode;
+#endif
+
+/*Releases dropped before the current execution , read by the callback through Sched_GetMissedReleases */
+static u32 MissedReleases;
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+/*Handler of the runnables over their budget , called from the SysTick */
+static Sched_BudgetHandler_t BudgetHandler;
+#endif
+
+#if SCHED_WATCHDOG == SCHED_ENABLE
+/*Longest tickless sleep , half of the watchdog timeout so the loop refreshes it in time */
+#define SCHED_WATCHDOG_MAX_SLEEP_TICKS	((SCHED_WATCHDOG_TIMEOUT_MS * SCHED_US_PER_MS) / (2 * TICK_TIME_US))
+#endif
+
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+/*Number of SysTick counts of one scheduler tick (Processor cycles as the SysTick is clocked by AHB)
+ *Read again when HCLK changes */
+static u32 TickCounts;
+#endif
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*Ticks counted since the start (In the numbering of the release ticks) & the cycle counter at the start of the latest one ,
+ *to measure the release latency */
+static volatile u32 JitterTickCount = SCHED_START_TICK;
+static volatile u32 JitterTickCycles;
+
+/*Processor cycles of one bucket of the jitter histograms , calculated from HCLK */
+static u32 JitterBucketCycles;
+#endif
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+/*Lengths of the windows of the CPU load monitor */
+static const u32 LoadWindowsMs[] = SCHED_LOAD_WINDOWS_MS;
+#define SCHED_LOAD_WINDOWS		(sizeof(LoadWindowsMs) / sizeof(LoadWindowsMs[0]))
+#define SCHED_LOAD_FULL			1000
+
+static SchedLoadWindow_t LoadWindows[SCHED_LOAD_WINDOWS];
+
+/*Cycles spent in the idle branch of Sched_Start , wraps around */
+static u32 IdleCycles;
+
+/*Published loads in per mille , written as one halfword to be read without locks */
+static volatile u16 PublishedLoad[SCHED_LOAD_WINDOWS];
+static volatile u16 PublishedPeakLoad;
+#endif
 
 
 /************************ Static Function Prototypes ***************************/
 
-static void Sched(void);
+static void Sched(SchedLevel_t *Level , u32 Ticks);
+static void Sched_DispatchEvents(SchedLevel_t *Level);
 static void Tickcb(void);
+static u32  Sched_TimeToTicks(u32 TimeMs , u32 TimeUs);
+static void Sched_InsertRelease(SchedLevel_t *Level , u8 RunnableIdx);
+static void Sched_UnlinkRelease(SchedLevel_t *Level , u8 RunnableIdx);
+static u8   Sched_IsReleasedBefore(u8 FirstIdx , u8 SecondIdx);
+static void Sched_FindListHead(SchedLevel_t *Level , u32 FromTick);
+static enumError_t Sched_SetupRunnable(u8 RunnableIdx , const Runnable_t *Runnable , u32 DelayTicks);
+static void Sched_FreeRunnable(u8 RunnableIdx);
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_PREEMPTIVE_MODE == SCHED_ENABLE)
+static s32  Sched_TicksToRelease(const SchedLevel_t *Level);
+#endif
+static SchedLevel_t *Sched_GetLevel(u8 RunnableIdx);
+static u8   Sched_IsContextAllowed(const SchedLevel_t *Level);
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+static void Sched_ReleaseHighPriority(u32 Ticks);
+static void Sched_PublishHighPriority(void);
+#endif
+static inline void Sched_RunRunnable(SchedLevel_t *Level , u8 RunnableIdx);
+#if SCHED_MODES == SCHED_ENABLE
+static void Sched_SwitchMode(u8 Mode);
+#endif
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+static void Sched_CheckBudget(SchedLevel_t *Level);
+#endif
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+static u64  Sched_Gcd(u64 Val1 , u64 Val2);
+#endif
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+static void Sched_UpdateLoad(void);
+#endif
+#if SCHED_JITTER == SCHED_ENABLE
+static void Sched_CountJitterTicks(u32 Ticks , u32 ElapsedCounts);
+static void Sched_RecordJitter(u8 RunnableIdx);
+#endif
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+static void Sched_UpdateClock(void);
+#endif
+#if SCHED_TICKLESS_MODE == SCHED_ENABLE
+static void Sched_TicklessIdle(void);
+#endif
 
 /***************************** Implementation **********************************/
 
@@ -51,26 +340,110 @@ enumError_t Sched_Init(void)
 
 	/*Configure Systick */
 	STK_SetConfig(STK_AHB_ENB_INT);
-	STK_SetTimeMs(TICK_TIME_MS);
+	STK_SetTimeUs(TICK_TIME_US);
 	STK_SetCallBack(Tickcb);
 
+#if (SCHED_PROFILING == SCHED_ENABLE) || (SCHED_TICK_PROFILING == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+	DWT_Init();
+#endif
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	BgLevel.RunningIdx = SCHED_NO_RUNNABLE;
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	HpLevel.RunningIdx = SCHED_NO_RUNNABLE;
+#endif
+#endif
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	/*The grouping is set once for the application , then SysTick must preempt PendSV
+	 *to keep counting the ticks while the high priority runnables are executing*/
+	u32 loc_PriorityStatus = Ok;
+	if ( (NVIC_SetPriorityGrouping(SCHED_PRIORITY_GROUP) != Ok)
+		|| (NVIC_SetSystemPriority(NVIC_SYS_SYSTICK , SCHED_SYSTICK_PREEMPT_PRIO , 0 , SCHED_PRIORITY_GROUP) != Ok)
+		|| (NVIC_SetSystemPriority(NVIC_SYS_PENDSV , SCHED_PENDSV_PREEMPT_PRIO , 0 , SCHED_PRIORITY_GROUP) != Ok) )
+	{
+		loc_PriorityStatus = Nok;
+	}
+#endif
+
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+	/*Keep the counts of one tick to reprogram the SysTick for long sleeps and restore it after
+	 *& to convert the ticks of a release latency or of a load window to cycles
+	 *The SysTick recalculates the tick first when HCLK changes (Its callback was added by STK_SetConfig) */
+	Sched_UpdateClock();
+	RCC_AddClockChangeCallBack(Sched_UpdateClock);
+#endif
+
 	/* Loop to fill struct RunnableInfoList with values of struct RunnableList
-	 * & Initiate the remaining time with DelayTimeMs
+	 * & Initiate the first release tick with DelayTimeMs + DelayTimeUs (Or the optimized offset generated by tools/Sched_Offsets.py)
+	 * Runnables without callback are never inserted in the timing wheel so they cost nothing per tick
+	 * Event triggered runnables take their bit of the ready bitmap in the order of RunnableList
 	 */
 	u8 loc_idx;
-	for (loc_idx=0 ; loc_idx < _MaxRunnables ; loc_idx++ )
+	u32 loc_SetupStatus = Ok;
+#if SCHED_MODES == SCHED_ENABLE
+	/* Started in the first mode */
+	const Runnable_t *loc_Table = SchedModeList[0];
+#else
+	const Runnable_t *loc_Table = RunnableList;
+#endif
+	for (loc_idx=0 ; SCHED_IS_TABLE_SLOT(loc_idx) ; loc_idx++ )
 	{
 		if(RunnableInfoList[loc_idx].runnable == NULL_PTR)
 		{
-			RunnableInfoList[loc_idx].runnable = &RunnableList[loc_idx];
-			RunnableInfoList[loc_idx].RemainingTimeMs = RunnableInfoList[loc_idx].runnable->DelayTimeMs;
-			Ret_ErrorStatus = Ok;
+#if SCHED_OPTIMIZED_OFFSETS == SCHED_ENABLE
+			if (Sched_SetupRunnable(loc_idx , &loc_Table[loc_idx] , Sched_TimeToTicks(0 , RunnableOffsetsUs[loc_idx])) != Ok)
+#else
+			if (Sched_SetupRunnable(loc_idx , &loc_Table[loc_idx] ,
+					Sched_TimeToTicks(loc_Table[loc_idx].DelayTimeMs , loc_Table[loc_idx].DelayTimeUs)) != Ok)
+#endif
+			{
+				/* More than SCHED_MAX_EVENT_RUNNABLES event runnables --> the extra ones are never executed */
+				loc_SetupStatus = Nok;
+			}
+			Ret_ErrorStatus = loc_SetupStatus;
 		}
 		/*empty else */
 		else
 		{
 		}
 	}
+
+	/* Chain the slots of the pool of the dynamic runnables in the free list */
+	for (loc_idx = _MaxRunnables ; loc_idx < SCHED_MAX_RUNNABLES ; loc_idx++)
+	{
+		if (RunnableInfoList[loc_idx].State == SCHED_STATE_FREE)
+		{
+			RunnableInfoList[loc_idx].Next = FreeListHead;
+			FreeListHead = loc_idx;
+		}
+	}
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+	for (loc_idx = 0 ; loc_idx < SCHED_LOAD_WINDOWS ; loc_idx++)
+	{
+		LoadWindows[loc_idx].LengthTicks = Sched_TimeToTicks(LoadWindowsMs[loc_idx] , 0);
+	}
+#endif
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	Sched_PublishHighPriority();
+
+	/* Wrong priorities --> SysTick can't preempt the high priority runnables */
+	if (loc_PriorityStatus != Ok)
+	{
+		Ret_ErrorStatus = loc_PriorityStatus;
+	}
+#endif
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+	/* The runnables stay set up , the caller decides to start or not */
+	if ( (Ret_ErrorStatus == Ok) && (Sched_CheckSchedulability(NULL_PTR) != Ok) )
+	{
+		Ret_ErrorStatus = Sched_NotSchedulable;
+	}
+#endif
+
 	return Ret_ErrorStatus;
 }
 
@@ -81,67 +454,1859 @@ enumError_t Sched_Init(void)
  * @details  : Starts the scheduler by enabling the system timer interrupts
  * 				& Entering an infinite loop where it checks for pending ticks & Executes the scheduler function accordingly
  *             	  Task should be created between Init and start.
+ *             	  In tickless mode the CPU sleeps till the nearest release instead of waking up every tick.
  */
 enumError_t Sched_Start(void)
 {
 	/*Variable to store error status to be returned at the end of the function */
 	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Ticks;
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+	u32 loc_IdleStart;
+	u8 loc_idx;
+
+	/* Windows start with the SysTick */
+	for (loc_idx = 0 ; loc_idx < SCHED_LOAD_WINDOWS ; loc_idx++)
+	{
+		LoadWindows[loc_idx].StartTick = BgLevel.Tick;
+		LoadWindows[loc_idx].StartCycles = DWT_GetCycleCount();
+		LoadWindows[loc_idx].StartIdle = IdleCycles;
+	}
+#endif
+
+#if SCHED_WATCHDOG == SCHED_ENABLE
+	IWDG_Init(SCHED_WATCHDOG_TIMEOUT_MS);
+#endif
 
 	STK_Start();
 	 /* Enter infinite loop for scheduler operation */
 	 while (1)
 	 {
+#if SCHED_WATCHDOG == SCHED_ENABLE
+		 /* A runnable which never returns stops the refreshes --> reset by the watchdog */
+		 IWDG_Refresh();
+#endif
+#if SCHED_MODES == SCHED_ENABLE
+		 if (RequestedMode != CurrentMode)
+		 {
+			 /* Between two passes no runnable of both levels is running --> switched before the next tick is processed */
+			 Core_DisableIRQ();
+			 Sched_SwitchMode(RequestedMode);
+			 Core_EnableIRQ();
+		 }
+#endif
 		 if (PendingTicks)
 		 {
-			 PendingTicks -- ;
-			 Sched();
+			 /* Take all the pending ticks at once , the tick interrupt must not update the counter in between
+			  * More than one tick --> the previous pass overran its tick , the late runnables are caught up by their policy */
+			 Core_DisableIRQ();
+			 loc_Ticks = PendingTicks;
+			 PendingTicks = 0;
+			 Core_EnableIRQ();
+
+			 Sched(&BgLevel , loc_Ticks);
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+			 Sched_UpdateLoad();
+#endif
 
 			 Ret_ErrorStatus = Ok;
 		 }
+		 else if (BgLevel.ReadyMask)
+		 {
+			 /* Event triggered runnables are executed when no tick is pending so they don't delay the periodic ones */
+			 Sched_DispatchEvents(&BgLevel);
+		 }
+		 else
+		 {
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+			 loc_IdleStart = DWT_GetCycleCount();
+#endif
+#if SCHED_TICKLESS_MODE == SCHED_ENABLE
+			 Sched_TicklessIdle();
+#else
+			 Core_Idle();
+#endif
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+			 IdleCycles += DWT_GetCycleCount() - loc_IdleStart;
+#endif
+		 }
 	 }
 
 	return Ret_ErrorStatus;
 }
 
 
-/************************ Implementation of Static Functions ***************************/
+/*
+ * @brief    : Adds a runnable at runtime.
+ * @param[in]: Runnable - Pointer to the runnable configuration , it must stay valid till the runnable is removed.
+ * @param[out]: RunnableIdx - Pointer to store the index given to the runnable (To remove it or read its statistics).
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free slot in the pool).
+ * @details  : The runnable takes a slot of the pool of SCHED_DYNAMIC_RUNNABLES slots , no dynamic memory is used.
+ *             Its first release is after DelayTimeMs + DelayTimeUs , a runnable with a period of 0 is removed automatically after it runs.
+ *             Times which are not multiple of TICK_TIME_US are rounded up to the next tick.
+ *             Can be called from a background runnable or from the main before Sched_Start ,
+ *             and for SCHED_PRIORITY_HIGH runnables from a high priority runnable as well.
+ */
+enumError_t Sched_AddRunnable(const Runnable_t *Runnable , u32 *RunnableIdx)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u8 loc_idx;
+	u32 loc_Primask;
+
+	if ( (Runnable == NULL_PTR) || (RunnableIdx == NULL_PTR) || (Runnable->cb == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		/* The lists are shared with PendSV --> the slot is taken & inserted with the interrupts disabled ,
+		 * their state is restored as the caller may have them already disabled */
+		loc_Primask = Core_SaveDisableIRQ();
+
+		loc_idx = FreeListHead;
+		if (loc_idx == SCHED_NO_RUNNABLE)
+		{
+			Ret_ErrorStatus = Nok;
+		}
+		else
+		{
+			/* Check the level of the new runnable through the slot before taking it from the free list */
+			RunnableInfoList[loc_idx].runnable = Runnable;
+			if (Sched_IsContextAllowed(Sched_GetLevel(loc_idx)) == 0)
+			{
+				RunnableInfoList[loc_idx].runnable = NULL_PTR;
+				Ret_ErrorStatus = WrongInput;
+			}
+			else
+			{
+				FreeListHead = RunnableInfoList[loc_idx].Next;
+				if (Sched_SetupRunnable(loc_idx , Runnable , Sched_TimeToTicks(Runnable->DelayTimeMs , Runnable->DelayTimeUs)) == Ok)
+				{
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+					Sched_PublishHighPriority();
+#endif
+					*RunnableIdx = loc_idx;
+					Ret_ErrorStatus = Ok;
+				}
+				else
+				{
+					/* No free event bit --> give the slot back */
+					Sched_FreeRunnable(loc_idx);
+					Ret_ErrorStatus = Nok;
+				}
+			}
+		}
+
+		Core_RestoreIRQ(loc_Primask);
+	}
+
+	return Ret_ErrorStatus;
+}
+
 
 /*
- * @brief    : Executes the scheduler.
- * @param[in]: None.
- * @return   : None.
- * @details  : Executes the scheduler by iterating through the list of runnables and calling their
- *             respective callback functions if the time condition is met.
+ * @brief    : Removes a runnable at runtime.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The runnable is not released anymore & its slot returns to the pool.
+ *             It can remove itself from its callback , the slot is freed when the callback returns.
+ *             Same calling contexts of Sched_AddRunnable.
  */
-static void Sched(void)
+enumError_t Sched_RemoveRunnable(u32 RunnableIdx)
 {
-	u32 loc_idx=0;
-	for(loc_idx=0 ; loc_idx < _MaxRunnables ; loc_idx++)
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	RunnableInfo_t *loc_Info;
+	u32 loc_Primask;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
 	{
-	  /* Checking that Callback equal value != nullptr && Remaining time == 0 --> time for this runnable to be executed */
-		if ( (RunnableInfoList[loc_idx].runnable->cb) && (RunnableInfoList[loc_idx].RemainingTimeMs==0) )
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		loc_Info = &RunnableInfoList[RunnableIdx];
+
+		loc_Primask = Core_SaveDisableIRQ();
+
+		if ( (loc_Info->runnable == NULL_PTR) || (Sched_IsContextAllowed(Sched_GetLevel(RunnableIdx)) == 0) )
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else if (loc_Info->State == SCHED_STATE_WAITING)
+		{
+			Sched_UnlinkRelease(Sched_GetLevel(RunnableIdx) , RunnableIdx);
+			Sched_FreeRunnable(RunnableIdx);
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+			Sched_PublishHighPriority();
+#endif
+			Ret_ErrorStatus = Ok;
+		}
+		else if (loc_Info->State == SCHED_STATE_EVENT)
+		{
+			/* Not in the timing wheel --> its ready bit is cleared when freed */
+			Sched_FreeRunnable(RunnableIdx);
+			Ret_ErrorStatus = Ok;
+		}
+		else if (loc_Info->State == SCHED_STATE_RUNNING)
 		{
-			/*  Calling the Call back function of this runnable
-			 * &Setting the remaining time by the periodicity time of this runnable */
-			RunnableList[loc_idx].cb();
-			RunnableInfoList[loc_idx].RemainingTimeMs = RunnableInfoList[loc_idx].runnable->PeriodicityMs;
+			/* Removing itself (Or preempted by the caller) --> Sched() frees it after the callback */
+			loc_Info->State = SCHED_STATE_REMOVED;
+			Ret_ErrorStatus = Ok;
+		}
+		else
+		{
+			/* Already removed */
+			Ret_ErrorStatus = WrongInput;
+		}
+
+		Core_RestoreIRQ(loc_Primask);
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Activates an event triggered runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure (WrongInput --> Not an event triggered runnable).
+ * @details  : Sets the ready bit of the runnable without disabling the interrupts , so it can be called from any ISR.
+ *             The runnable is executed once by its level (The loop of Sched_Start or PendSV for SCHED_PRIORITY_HIGH)
+ *             whatever the number of activations before it runs. Ready runnables are executed by the order of their ready bit ,
+ *             the event runnables of RunnableList first in their order then the added ones.
+ */
+enumError_t Sched_ActivateRunnable(u32 RunnableIdx)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	RunnableInfo_t *loc_Info;
+	SchedLevel_t *loc_Level;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		loc_Info = &RunnableInfoList[RunnableIdx];
 
+		/* Slots are freed with the interrupts disabled --> an ISR never sees a runnable half removed */
+		if ( (loc_Info->State != SCHED_STATE_EVENT) && ( (loc_Info->State != SCHED_STATE_RUNNING) || (loc_Info->EventBit == SCHED_NO_EVENT) ) )
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else
+		{
+			loc_Level = Sched_GetLevel(RunnableIdx);
+			Core_AtomicSetBits(&loc_Level->ReadyMask , SCHED_EVENT_MASK(loc_Info->EventBit));
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+			if (loc_Level == &HpLevel)
+			{
+				NVIC_SetPending_PendSV();
+			}
+#endif
+			Ret_ErrorStatus = Ok;
 		}
-		RunnableInfoList[loc_idx].RemainingTimeMs -= TICK_TIME_MS ;
 	}
+
+	return Ret_ErrorStatus;
 }
 
 
 /*
- * @brief    : Callback function for system timer interrupts.
+ * @brief    : Gets the scheduler time of the calling runnable.
  * @param[in]: None.
- * @return   : None.
- * @details  : Increments the pending ticks counter upon system timer interrupt.
+ * @return   : u32 - Time in milliseconds of the tick processed by the level of the caller , wraps around every 2 pwr 32 ms.
+ * @details  : Used by SCHED_WAIT_MS of Service/Sched_Coroutine.h. It has the resolution of TICK_TIME_US rounded down to 1 ms.
  */
-static void Tickcb(void)
+u32 Sched_GetTimeMs(void)
 {
+	const SchedLevel_t *loc_Level = &BgLevel;
 
-	PendingTicks++;
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	if (Core_GetActiveException() == NVIC_SYS_PENDSV)
+	{
+		loc_Level = &HpLevel;
+	}
+#endif
+
+	return (u32)( ((u64)(loc_Level->Tick - SCHED_START_TICK) * TICK_TIME_US) / SCHED_US_PER_MS );
+}
+
+
+/*
+ * @brief    : Gets the number of overruns of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Overruns - Pointer to store the number of releases executed or dropped at least one tick late.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetOverrunCount(u32 RunnableIdx , u32 *Overruns)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Overruns == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Overruns = RunnableInfoList[RunnableIdx].OverrunCount;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the releases dropped before the current execution of a SCHED_CATCHUP_COALESCE runnable.
+ * @param[in]: None.
+ * @return   : u32 - Number of missed releases coalesced in the current call (0 --> released on time).
+ * @details  : Valid only when called from the callback of the runnable.
+ */
+u32 Sched_GetMissedReleases(void)
+{
+	return MissedReleases;
+}
+
+
+#if SCHED_PROFILING == SCHED_ENABLE
+/*
+ * @brief    : Gets the execution time statistics of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Stats - Pointer to store the statistics in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_PROFILING is enabled , Sched_Init starts the DWT cycle counter.
+ */
+enumError_t Sched_GetRunnableStats(u32 RunnableIdx , Sched_RunnableStats_t *Stats)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Stats == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		Stats->Count = RunnableInfoList[RunnableIdx].ExecCount;
+		Stats->MaxCycles = RunnableInfoList[RunnableIdx].MaxCycles;
+
+		/* No execution yet --> Zeros instead of the initial values */
+		if (Stats->Count)
+		{
+			Stats->MinCycles = RunnableInfoList[RunnableIdx].MinCycles;
+			Stats->AvgCycles = (u32)(RunnableInfoList[RunnableIdx].TotalCycles / Stats->Count);
+		}
+		else
+		{
+			Stats->MinCycles = 0;
+			Stats->AvgCycles = 0;
+		}
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Clears the execution time statistics of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetRunnableStats(u32 RunnableIdx)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		RunnableInfoList[RunnableIdx].ExecCount = 0;
+		RunnableInfoList[RunnableIdx].MinCycles = SCHED_MIN_CYCLES_INIT;
+		RunnableInfoList[RunnableIdx].MaxCycles = 0;
+		RunnableInfoList[RunnableIdx].TotalCycles = 0;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+#endif
+
+
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+/*
+ * @brief    : Gets the cycles spent by the scheduler in its ticks.
+ * @param[out]: Stats - Pointer to store the statistics in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_TICK_PROFILING is enabled , Sched_Init starts the DWT cycle counter.
+ *             Build the RunnableList with runnables of empty callbacks to benchmark the tick against _MaxRunnables.
+ */
+enumError_t Sched_GetTickStats(Sched_TickStats_t *Stats)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Stats == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		Stats->Count = TickCount;
+		Stats->MaxCycles = TickMaxCycles;
+
+		/* No tick yet --> Zero instead of dividing by zero */
+		Stats->AvgCycles = (TickCount) ? (u32)(TickTotalCycles / TickCount) : 0;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Clears the cycles spent by the scheduler in its ticks.
+ * @param[in]: None.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetTickStats(void)
+{
+	TickCount = 0;
+	TickMaxCycles = 0;
+	TickTotalCycles = 0;
+
+	return Ok;
+}
+#endif
+
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+/*
+ * @brief    : Gets the CPU load over the last completed window.
+ * @param[in]: WindowIdx - Index of the window in SCHED_LOAD_WINDOWS_MS.
+ * @param[out]: LoadPerMille - Pointer to store the load in it (0 --> idle , 1000 --> fully loaded).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_LOAD_MONITOR is enabled. The load is published by the scheduler
+ *             as one halfword so it can be read from any runnable or ISR without locks.
+ *             Interrupts served while idle are counted idle.
+ */
+enumError_t Sched_GetCpuLoad(u32 WindowIdx , u16 *LoadPerMille)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (WindowIdx >= SCHED_LOAD_WINDOWS)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (LoadPerMille == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*LoadPerMille = PublishedLoad[WindowIdx];
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the highest load of the shortest window since the start or Sched_ResetPeakCpuLoad.
+ * @param[out]: LoadPerMille - Pointer to store the load in it (0 --> idle , 1000 --> fully loaded).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetPeakCpuLoad(u16 *LoadPerMille)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (LoadPerMille == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*LoadPerMille = PublishedPeakLoad;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Restarts the tracking of the peak load.
+ * @param[in]: None.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetPeakCpuLoad(void)
+{
+	PublishedPeakLoad = 0;
+
+	return Ok;
+}
+#endif
+
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*
+ * @brief    : Gets the release latency histogram of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Histogram - Pointer to store a copy of the histogram in it.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Available only when SCHED_JITTER is enabled , only the periodic releases are measured.
+ */
+enumError_t Sched_GetJitterHistogram(u32 RunnableIdx , Sched_JitterHistogram_t *Histogram)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u32 loc_Primask;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Histogram == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		/* A high priority runnable may be recorded by PendSV in the middle of the copy */
+		loc_Primask = Core_SaveDisableIRQ();
+		*Histogram = RunnableInfoList[RunnableIdx].Jitter;
+		Core_RestoreIRQ(loc_Primask);
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Clears the release latency histogram of a runnable.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_ResetJitterHistogram(u32 RunnableIdx)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u8 loc_Bucket;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		for (loc_Bucket = 0 ; loc_Bucket < SCHED_JITTER_BUCKETS ; loc_Bucket++)
+		{
+			RunnableInfoList[RunnableIdx].Jitter.Counts[loc_Bucket] = 0;
+		}
+		RunnableInfoList[RunnableIdx].Jitter.MaxLatencyCycles = 0;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Passes the release latency histogram of every runnable in use to a function.
+ * @param[in]: DumpCB - Function printing or sending the histogram (e.g. over UART from a low rate runnable).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_DumpJitterHistograms(Sched_JitterDumpCB_t DumpCB)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	Sched_JitterHistogram_t loc_Histogram;
+	const Runnable_t *loc_Runnable;
+	u8 loc_idx;
+
+	if (DumpCB == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		for (loc_idx = 0 ; loc_idx < SCHED_MAX_RUNNABLES ; loc_idx++)
+		{
+			loc_Runnable = RunnableInfoList[loc_idx].runnable;
+			if ( (loc_Runnable != NULL_PTR) && (loc_Runnable->cb != NULL_PTR) )
+			{
+				Sched_GetJitterHistogram(loc_idx , &loc_Histogram);
+				DumpCB(loc_idx , loc_Runnable->Name , &loc_Histogram);
+			}
+		}
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+#endif
+
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+/*
+ * @brief    : Checks if the periodic runnables in use fit in the CPU.
+ * @param[out]: Report - Pointer to store the utilization & the worst tick load in it (NULL_PTR --> not needed).
+ * @return   : enumError_t - Ok , Sched_NotSchedulable (Utilization or worst tick load above SCHED_LOAD_LIMIT_PERMILLE).
+ * @details  : The ticks of the hyperperiod (At most SCHED_CHECK_MAX_TICKS) are replayed twice from the next release
+ *             of every runnable , so the work left at the end of the hyperperiod is carried into its start.
+ *             The load of a tick is the WCET of its releases + the work left by the previous ticks.
+ */
+enumError_t Sched_CheckSchedulability(Sched_Schedulability_t *Report)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Ok;
+	u32 loc_Wcet[SCHED_MAX_RUNNABLES];		/*WCET in cycles of the counted runnables */
+	u32 loc_Period[SCHED_MAX_RUNNABLES];	/*Period in ticks */
+	u32 loc_Wait[SCHED_MAX_RUNNABLES];		/*Ticks to the next release during the replay */
+	u32 loc_Count = 0;
+	u64 loc_Utilization = 0;
+	u64 loc_Hyperperiod = 1;
+	u64 loc_Load = 0;
+	u64 loc_PeakLoad = 0;
+	u32 loc_PeakTick = 0;
+	u32 loc_Ticks;
+	u32 loc_Tick;
+	u32 loc_idx;
+	s32 loc_ToRelease;
+	const RunnableInfo_t *loc_Info;
+	u32 loc_CyclesPerUs = RCC_Get_HclkFreq() / SCHED_US_PER_SEC;
+	u32 loc_TickCycles = loc_CyclesPerUs * TICK_TIME_US;
+
+	for (loc_idx = 0 ; loc_idx < SCHED_MAX_RUNNABLES ; loc_idx++)
+	{
+		loc_Info = &RunnableInfoList[loc_idx];
+		if ( ((loc_Info->State == SCHED_STATE_WAITING) || (loc_Info->State == SCHED_STATE_RUNNING)) && (loc_Info->PeriodTicks != 0) )
+		{
+			loc_Wcet[loc_Count] = loc_Info->runnable->WcetUs * loc_CyclesPerUs;
+#if SCHED_CALIBRATION == SCHED_ENABLE
+			if (loc_Info->MaxCycles > loc_Wcet[loc_Count])
+			{
+				loc_Wcet[loc_Count] = loc_Info->MaxCycles;
+			}
+#endif
+			/* Only the phase matters , a release already due is replayed at the first tick */
+			loc_ToRelease = (s32)(loc_Info->ReleaseTick - Sched_GetLevel(loc_idx)->Tick);
+			loc_Period[loc_Count] = loc_Info->PeriodTicks;
+			loc_Wait[loc_Count] = (loc_ToRelease > 0) ? ((u32)loc_ToRelease % loc_Info->PeriodTicks) : 0;
+
+			loc_Utilization += ((u64)loc_Wcet[loc_Count] * SCHED_FULL_LOAD_PERMILLE) / loc_Info->PeriodTicks;
+			if (loc_Hyperperiod <= SCHED_MAX_HYPERPERIOD)
+			{
+				loc_Hyperperiod = (loc_Hyperperiod / Sched_Gcd(loc_Hyperperiod , loc_Info->PeriodTicks)) * loc_Info->PeriodTicks;
+			}
+			loc_Count++;
+		}
+	}
+	loc_Utilization /= loc_TickCycles;
+
+	loc_Ticks = (loc_Hyperperiod < SCHED_CHECK_MAX_TICKS) ? (u32)loc_Hyperperiod : SCHED_CHECK_MAX_TICKS;
+	for (loc_Tick = 0 ; loc_Tick < (2 * loc_Ticks) ; loc_Tick++)
+	{
+		for (loc_idx = 0 ; loc_idx < loc_Count ; loc_idx++)
+		{
+			if (loc_Wait[loc_idx] == 0)
+			{
+				loc_Load += loc_Wcet[loc_idx];
+				loc_Wait[loc_idx] = loc_Period[loc_idx];
+			}
+			loc_Wait[loc_idx]--;
+		}
+
+		if (loc_Load > loc_PeakLoad)
+		{
+			loc_PeakLoad = loc_Load;
+			loc_PeakTick = loc_Tick % loc_Ticks;
+		}
+
+		/* The tick executes loc_TickCycles of the load at most , the rest is left to the next one */
+		loc_Load = (loc_Load > loc_TickCycles) ? (loc_Load - loc_TickCycles) : 0;
+	}
+	loc_PeakLoad = (loc_PeakLoad * SCHED_FULL_LOAD_PERMILLE) / loc_TickCycles;
+
+	if ( (loc_Utilization > SCHED_LOAD_LIMIT_PERMILLE) || (loc_PeakLoad > SCHED_LOAD_LIMIT_PERMILLE) )
+	{
+		Ret_ErrorStatus = Sched_NotSchedulable;
+	}
+
+	if (Report != NULL_PTR)
+	{
+		Report->UtilizationPerMille = (u32)loc_Utilization;
+		Report->PeakTickLoadPerMille = (u32)loc_PeakLoad;
+		Report->PeakTick = loc_PeakTick;
+		Report->HyperperiodTicks = (loc_Hyperperiod <= SCHED_MAX_HYPERPERIOD) ? (u32)loc_Hyperperiod : 0;
+	}
+
+	return Ret_ErrorStatus;
+}
+#endif
+
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+/*
+ * @brief    : Sets the handler of the runnables over their execution budget.
+ * @param[in]: Handler - Function choosing the action (NULL_PTR --> the overruns are only counted).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The handler runs in the SysTick interrupt , it must be short (e.g. log the index & return the action).
+ */
+enumError_t Sched_SetBudgetHandler(Sched_BudgetHandler_t Handler)
+{
+	BudgetHandler = Handler;
+
+	return Ok;
+}
+
+
+/*
+ * @brief    : Gets the number of executions of a runnable which exceeded its budget.
+ * @param[in]: RunnableIdx - Index of the runnable (In RunnableList or given by Sched_AddRunnable).
+ * @param[out]: Overruns - Pointer to store the number of executions over BudgetUs.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetBudgetOverruns(u32 RunnableIdx , u32 *Overruns)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (RunnableIdx >= SCHED_MAX_RUNNABLES)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else if (Overruns == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Overruns = RunnableInfoList[RunnableIdx].BudgetOverruns;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+#endif
+
+
+#if SCHED_MODES == SCHED_ENABLE
+/*
+ * @brief    : Requests the switch to another operating mode.
+ * @param[in]: Mode - Index of the mode in SchedModeList (SchedModesList_t).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Only the request is written (One byte) , so it can be called from any runnable or ISR.
+ *             The background loop applies it by Sched_SwitchMode before its next tick.
+ */
+enumError_t Sched_SetMode(u32 Mode)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Mode >= _MaxSchedModes)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		RequestedMode = (u8)Mode;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the current operating mode.
+ * @param[out]: Mode - Pointer to store the index of the mode applied (Not the one requested yet).
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t Sched_GetMode(u32 *Mode)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+
+	if (Mode == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else
+	{
+		*Mode = CurrentMode;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+#endif
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief    : Executes the scheduler.
+ * @param[in]: Level - Scheduling level to be processed (Background or High priority).
+ * @param[in]: Ticks - Number of ticks passed since the previous call.
+ * @return   : None.
+ * @details  : Executes the scheduler by popping the runnables whose release tick is reached in release order
+ *             from the timing wheel , calling their callback functions and re-inserting them with their next release.
+ *             A tick without due runnables costs a single comparison whatever the number of runnables.
+ *             A runnable found after its release tick is an overrun , it is counted & caught up by its CatchUpPolicy.
+ */
+static void Sched(SchedLevel_t *Level , u32 Ticks)
+{
+	u8 loc_idx;
+	u32 loc_LateTicks;
+	u32 loc_Missed;
+	u32 loc_SavedMissed;	/*A high priority runnable may preempt a background one while it reads MissedReleases */
+	RunnableInfo_t *loc_Info;
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+	u32 loc_StartCycles = DWT_GetCycleCount();
+	u32 loc_Cycles;
+#endif
+
+	/* Jump to the latest passed tick , releases of the skipped ticks are found late below */
+	Level->Tick += Ticks - 1;
+
+	/* ListHead is the nearest release of the wheel --> Only it needs to be checked
+	 * (s32) of the difference keeps the comparison valid when the tick counter wraps around
+	 */
+	while ( (Level->ListHead != SCHED_NO_RUNNABLE) && ( (s32)(Level->Tick - RunnableInfoList[Level->ListHead].ReleaseTick) >= 0 ) )
+	{
+		/* Remove the runnable with the nearest release from the wheel */
+		loc_idx = Level->ListHead;
+		loc_Info = &RunnableInfoList[loc_idx];
+		Sched_UnlinkRelease(Level , loc_idx);
+
+		/* Releases passed after this one while the runnable was waiting */
+		loc_LateTicks = Level->Tick - loc_Info->ReleaseTick;
+		loc_Missed = 0;
+		if (loc_Info->PeriodTicks)
+		{
+			loc_Missed = loc_LateTicks / loc_Info->PeriodTicks;
+		}
+
+		if (loc_LateTicks)
+		{
+			loc_Info->OverrunCount++;
+		}
+
+		/* Run all --> execute only this release now , the next one is still due so it is popped again in this loop
+		 * Skip or Coalesce --> execute once & continue from the release after the latest missed one */
+		if (loc_Info->runnable->CatchUpPolicy == SCHED_CATCHUP_ALL)
+		{
+			loc_Missed = 0;
+		}
+		else
+		{
+			loc_Info->OverrunCount += loc_Missed;
+		}
+
+		/*  Calling the Call back function of this runnable
+		 * & Setting the next release by the periodicity of this runnable
+		 * Periodicity of zero or removed by its callback --> not inserted again */
+		loc_SavedMissed = MissedReleases;
+		MissedReleases = (loc_Info->runnable->CatchUpPolicy == SCHED_CATCHUP_COALESCE) ? loc_Missed : 0;
+		loc_Info->State = SCHED_STATE_RUNNING;
+#if SCHED_JITTER == SCHED_ENABLE
+		Sched_RecordJitter(loc_idx);
+#endif
+		Sched_RunRunnable(Level , loc_idx);
+		MissedReleases = loc_SavedMissed;
+
+		if ( (loc_Info->PeriodTicks) && (loc_Info->State == SCHED_STATE_RUNNING) )
+		{
+			loc_Info->ReleaseTick += (loc_Missed + 1) * loc_Info->PeriodTicks;
+			loc_Info->State = SCHED_STATE_WAITING;
+			Sched_InsertRelease(Level , loc_idx);
+		}
+		else
+		{
+			/* The free list & event bits are shared by both levels */
+			Core_DisableIRQ();
+			Sched_FreeRunnable(loc_idx);
+			Core_EnableIRQ();
+		}
+	}
+
+	Level->Tick++;
+
+#if SCHED_TICK_PROFILING == SCHED_ENABLE
+	/* Only the background ticks are measured , the high priority ones preempt them & are counted inside them
+	 * Unsigned difference stays valid when CYCCNT wraps around between the two reads */
+	if (Level == &BgLevel)
+	{
+		loc_Cycles = DWT_GetCycleCount() - loc_StartCycles;
+		TickCount++;
+		TickTotalCycles += loc_Cycles;
+		if (loc_Cycles > TickMaxCycles)
+		{
+			TickMaxCycles = loc_Cycles;
+		}
+	}
+#endif
+}
+
+
+/*
+ * @brief    : Executes the ready event triggered runnables of a level.
+ * @param[in]: Level - Scheduling level to be processed (Background or High priority).
+ * @return   : None.
+ * @details  : The next ready runnable is found by CLZ over the ready bitmap , so the dispatch does not depend
+ *             on the number of runnables. Only the runnables ready at the call are executed , an activation
+ *             during the pass (Even of the running one) is executed by the next call.
+ */
+static void Sched_DispatchEvents(SchedLevel_t *Level)
+{
+	u32 loc_Ready = Level->ReadyMask;
+	u32 loc_Bit;
+	u8 loc_idx;
+	u32 loc_SavedMissed;
+	RunnableInfo_t *loc_Info;
+
+	/* Bits cleared by a runnable removed during the pass are dropped from the snapshot */
+	while ( (loc_Ready &= Level->ReadyMask) != 0 )
+	{
+		loc_Bit = Core_CountLeadingZeros(loc_Ready);
+		loc_Ready &= ~SCHED_EVENT_MASK(loc_Bit);
+
+		/* Cleared before the callback so an activation while it is running is not lost */
+		Core_AtomicClearBits(&Level->ReadyMask , SCHED_EVENT_MASK(loc_Bit));
+
+		loc_idx = EventRunnables[loc_Bit];
+		loc_Info = &RunnableInfoList[loc_idx];
+
+		loc_SavedMissed = MissedReleases;
+		MissedReleases = 0;
+		loc_Info->State = SCHED_STATE_RUNNING;
+		Sched_RunRunnable(Level , loc_idx);
+		MissedReleases = loc_SavedMissed;
+
+		if (loc_Info->State == SCHED_STATE_RUNNING)
+		{
+			loc_Info->State = SCHED_STATE_EVENT;
+		}
+		else
+		{
+			/* Removed by its callback */
+			Core_DisableIRQ();
+			Sched_FreeRunnable(loc_idx);
+			Core_EnableIRQ();
+		}
+	}
+}
+
+
+/*
+ * @brief    : Executes the callback of a runnable.
+ * @param[in]: Level - Scheduling level executing the runnable.
+ * @param[in]: RunnableIdx - Index of the runnable in RunnableInfoList.
+ * @return   : None.
+ * @details  : When SCHED_PROFILING is enabled the callback is timestamped with the DWT cycle counter
+ *             & its execution time is added to the statistics of the runnable.
+ *             When SCHED_BUDGET_ENFORCEMENT is enabled the runnable is published to the SysTick with its budget ,
+ *             one more tick is given as the callback may start at the end of a tick.
+ */
+static inline void Sched_RunRunnable(SchedLevel_t *Level , u8 RunnableIdx)
+{
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	/* The budget is set before the index so the SysTick never checks the previous budget against this runnable */
+	Level->BudgetLeft = (RunnableInfoList[RunnableIdx].BudgetTicks) ? (RunnableInfoList[RunnableIdx].BudgetTicks + 1) : 0;
+	Level->RunningIdx = RunnableIdx;
+#else
+	(void)Level;
+#endif
+
+#if SCHED_PROFILING == SCHED_ENABLE
+	RunnableInfo_t *loc_Info = &RunnableInfoList[RunnableIdx];
+	u32 loc_StartCycles = DWT_GetCycleCount();
+
+	loc_Info->runnable->cb();
+
+	/* Unsigned subtraction keeps the result right when CYCCNT wraps around */
+	u32 loc_Cycles = DWT_GetCycleCount() - loc_StartCycles;
+
+	loc_Info->ExecCount++;
+	loc_Info->TotalCycles += loc_Cycles;
+	if (loc_Cycles < loc_Info->MinCycles)
+	{
+		loc_Info->MinCycles = loc_Cycles;
+	}
+	if (loc_Cycles > loc_Info->MaxCycles)
+	{
+		loc_Info->MaxCycles = loc_Cycles;
+	}
+#else
+	RunnableInfoList[RunnableIdx].runnable->cb();
+#endif
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	Level->RunningIdx = SCHED_NO_RUNNABLE;
+#endif
+}
+
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+/*
+ * @brief    : Counts down the budget of the running runnable of a level.
+ * @param[in]: Level - Scheduling level to be checked.
+ * @return   : None.
+ * @details  : Called by the SysTick every tick. When the budget is consumed the overrun is counted once per execution
+ *             & the action of the handler is applied (Suspended like a runnable removed while running).
+ */
+static void Sched_CheckBudget(SchedLevel_t *Level)
+{
+	u8 loc_idx = Level->RunningIdx;
+	u8 loc_Action = SCHED_BUDGET_CONTINUE;
+
+	if ( (loc_idx != SCHED_NO_RUNNABLE) && (Level->BudgetLeft != 0) )
+	{
+		Level->BudgetLeft--;
+		if (Level->BudgetLeft == 0)
+		{
+			RunnableInfoList[loc_idx].BudgetOverruns++;
+			if (BudgetHandler != NULL_PTR)
+			{
+				loc_Action = BudgetHandler(loc_idx);
+			}
+
+			if (loc_Action == SCHED_BUDGET_RESET)
+			{
+				NVIC_SystemReset();
+			}
+			else if ( (loc_Action == SCHED_BUDGET_SUSPEND) && (RunnableInfoList[loc_idx].State == SCHED_STATE_RUNNING) )
+			{
+				/* Freed by its level when the callback returns */
+				RunnableInfoList[loc_idx].State = SCHED_STATE_REMOVED;
+			}
+			else
+			{
+			}
+		}
+	}
+}
+#endif
+
+
+#if SCHED_MODES == SCHED_ENABLE
+/*
+ * @brief    : Switches the static runnables to the table of a mode.
+ * @param[in]: Mode - Index of the mode in SchedModeList.
+ * @return   : None.
+ * @details  : Called by the background loop between two passes with the interrupts disabled , so no runnable is running
+ *             & both levels switch at the same tick. A runnable active in both tables with the same trigger & priority
+ *             keeps its release tick , statistics & pending activation , only its configuration , period & budget are
+ *             taken from the new table. The others leave first to give their event bits back , then the runnables
+ *             of the new table which are idle (Joining the mode , one shot done or removed) are set up from the tick
+ *             of their level. The inactive runnables stay out of the timing wheels & the ready bitmaps.
+ */
+static void Sched_SwitchMode(u8 Mode)
+{
+	const Runnable_t *loc_Table = SchedModeList[Mode];
+	const Runnable_t *loc_New;
+	RunnableInfo_t *loc_Info;
+	u8 loc_idx;
+
+	for (loc_idx = 0 ; SCHED_IS_TABLE_SLOT(loc_idx) ; loc_idx++)
+	{
+		loc_Info = &RunnableInfoList[loc_idx];
+		loc_New = &loc_Table[loc_idx];
+
+		if ( (loc_Info->State == SCHED_STATE_WAITING) || (loc_Info->State == SCHED_STATE_EVENT) )
+		{
+			if ( (loc_New->cb != NULL_PTR) && (loc_New->Trigger == loc_Info->runnable->Trigger)
+					&& (loc_New->Priority == loc_Info->runnable->Priority) )
+			{
+				/* Shared by both modes --> the next release is kept , the new period applies after it */
+				loc_Info->runnable = loc_New;
+				loc_Info->PeriodTicks = Sched_TimeToTicks(loc_New->PeriodicityMs , loc_New->PeriodicityUs);
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+				loc_Info->BudgetTicks = Sched_TimeToTicks(0 , loc_New->BudgetUs);
+#endif
+			}
+			else
+			{
+				/* Unlinked from the level of its old configuration */
+				if (loc_Info->State == SCHED_STATE_WAITING)
+				{
+					Sched_UnlinkRelease(Sched_GetLevel(loc_idx) , loc_idx);
+				}
+				Sched_FreeRunnable(loc_idx);
+			}
+		}
+	}
+
+	for (loc_idx = 0 ; SCHED_IS_TABLE_SLOT(loc_idx) ; loc_idx++)
+	{
+		loc_Info = &RunnableInfoList[loc_idx];
+		loc_New = &loc_Table[loc_idx];
+
+		if (loc_Info->State == SCHED_STATE_IDLE)
+		{
+			if (loc_New->cb != NULL_PTR)
+			{
+				/* No free event bit --> left idle like in Sched_Init */
+				Sched_SetupRunnable(loc_idx , loc_New , Sched_TimeToTicks(loc_New->DelayTimeMs , loc_New->DelayTimeUs));
+			}
+			else
+			{
+				/* Inactive in the mode , its statistics are kept */
+				loc_Info->runnable = loc_New;
+			}
+		}
+	}
+
+	CurrentMode = Mode;
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	Sched_PublishHighPriority();
+#endif
+}
+#endif
+
+
+#if SCHED_LOAD_MONITOR == SCHED_ENABLE
+/*
+ * @brief    : Publishes the CPU load of the windows which ended.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Called by the background loop after the ticks are processed. The busy cycles are the cycles counted
+ *             in the window minus the idle ones , the length of the window is taken from the SysTick ticks passed.
+ *             So the load stays right in tickless mode whether the cycle counter stops during the sleep or not.
+ */
+static void Sched_UpdateLoad(void)
+{
+	SchedLoadWindow_t *loc_Window;
+	u32 loc_Now = DWT_GetCycleCount();
+	u32 loc_Ticks;
+	u32 loc_Busy;
+	u64 loc_Load;
+	u8 loc_idx;
+
+	for (loc_idx = 0 ; loc_idx < SCHED_LOAD_WINDOWS ; loc_idx++)
+	{
+		loc_Window = &LoadWindows[loc_idx];
+		loc_Ticks = BgLevel.Tick - loc_Window->StartTick;
+
+		if (loc_Ticks >= loc_Window->LengthTicks)
+		{
+			/* Unsigned subtractions keep the results right when the counters wrap around */
+			loc_Busy = (loc_Now - loc_Window->StartCycles) - (IdleCycles - loc_Window->StartIdle);
+			loc_Load = ((u64)loc_Busy * SCHED_LOAD_FULL) / ((u64)loc_Ticks * TickCounts);
+			if (loc_Load > SCHED_LOAD_FULL)
+			{
+				loc_Load = SCHED_LOAD_FULL;
+			}
+
+			PublishedLoad[loc_idx] = (u16)loc_Load;
+			if ( (loc_idx == 0) && (loc_Load > PublishedPeakLoad) )
+			{
+				PublishedPeakLoad = (u16)loc_Load;
+			}
+
+			loc_Window->StartTick = BgLevel.Tick;
+			loc_Window->StartCycles = loc_Now;
+			loc_Window->StartIdle = IdleCycles;
+		}
+	}
+}
+#endif
+
+
+#if SCHED_JITTER == SCHED_ENABLE
+/*
+ * @brief    : Counts the ticks passed for the release latency measurement.
+ * @param[in]: Ticks - Number of passed ticks.
+ * @param[in]: ElapsedCounts - SysTick counts elapsed since the start of the latest tick.
+ * @return   : None.
+ * @details  : Called from the SysTick handler or with the interrupts disabled. The start of the latest tick
+ *             is kept in cycles so the interrupt latency of the tick is not counted as release latency.
+ */
+static void Sched_CountJitterTicks(u32 Ticks , u32 ElapsedCounts)
+{
+	JitterTickCount += Ticks;
+	JitterTickCycles = DWT_GetCycleCount() - ElapsedCounts;
+}
+
+
+/*
+ * @brief    : Adds the latency of the current release of a runnable to its histogram.
+ * @param[in]: RunnableIdx - Index of the runnable in RunnableInfoList.
+ * @return   : None.
+ * @details  : Called just before the callback. The latency is the ticks passed since the release tick
+ *             plus the cycles since the start of the latest tick , so a release found late is measured fully.
+ */
+static void Sched_RecordJitter(u8 RunnableIdx)
+{
+	RunnableInfo_t *loc_Info = &RunnableInfoList[RunnableIdx];
+	u32 loc_TickCount;
+	u32 loc_TickCycles;
+	u32 loc_Latency;
+	u32 loc_Bucket;
+
+	Core_DisableIRQ();
+	loc_TickCount = JitterTickCount;
+	loc_TickCycles = JitterTickCycles;
+	Core_EnableIRQ();
+
+	/* Release tick N starts with the tick number N + 1 counted since the start */
+	loc_Latency = ( (loc_TickCount - (loc_Info->ReleaseTick + 1)) * TickCounts ) + (DWT_GetCycleCount() - loc_TickCycles);
+
+	loc_Bucket = loc_Latency / JitterBucketCycles;
+	if (loc_Bucket >= SCHED_JITTER_BUCKETS)
+	{
+		loc_Bucket = SCHED_JITTER_BUCKETS - 1;
+	}
+
+	loc_Info->Jitter.Counts[loc_Bucket]++;
+	if (loc_Latency > loc_Info->Jitter.MaxLatencyCycles)
+	{
+		loc_Info->Jitter.MaxLatencyCycles = loc_Latency;
+	}
+}
+#endif
+
+
+#if SCHED_SCHEDULABILITY_CHECK == SCHED_ENABLE
+/*
+ * @brief    : Calculates the greatest common divisor (Euclid).
+ * @param[in]: Val1 , Val2 - Values , not both 0.
+ * @return   : u64 - GCD of the values.
+ */
+static u64 Sched_Gcd(u64 Val1 , u64 Val2)
+{
+	u64 loc_Rem;
+
+	while (Val2 != 0)
+	{
+		loc_Rem = Val1 % Val2;
+		Val1 = Val2;
+		Val2 = loc_Rem;
+	}
+
+	return Val1;
+}
+#endif
+
+
+/*
+ * @brief    : Converts a time of a runnable to scheduler ticks.
+ * @param[in]: TimeMs - Milliseconds part of the time.
+ * @param[in]: TimeUs - Microseconds added to TimeMs.
+ * @return   : u32 - Number of ticks , rounded up so a runnable never runs faster than configured.
+ * @details  : Exact for the times of RunnableList since TICK_TIME_US is generated as their GCD.
+ */
+static u32 Sched_TimeToTicks(u32 TimeMs , u32 TimeUs)
+{
+	u64 loc_TimeUs = ((u64)TimeMs * SCHED_US_PER_MS) + TimeUs;
+
+	return (u32)( (loc_TimeUs + TICK_TIME_US - 1) / TICK_TIME_US );
+}
+
+
+/*
+ * @brief    : Inserts a runnable in the timing wheel of a level.
+ * @param[in]: Level - Scheduling level of the runnable.
+ * @param[in]: RunnableIdx - Index of the runnable in RunnableInfoList.
+ * @return   : None.
+ * @details  : Keeps the slot of its release tick sorted by release tick , runnables released at the same tick
+ *             are kept sorted by their index to execute in the same order of RunnableList.
+ *             Only the runnables of the slot are walked (Around the runnables / SCHED_WHEEL_SLOTS).
+ */
+static void Sched_InsertRelease(SchedLevel_t *Level , u8 RunnableIdx)
+{
+	u32 loc_Slot = SCHED_WHEEL_SLOT(RunnableInfoList[RunnableIdx].ReleaseTick);
+	u8 loc_Prev = SCHED_NO_RUNNABLE;
+	u8 loc_Curr = Level->Wheel[loc_Slot];
+
+	/* Walk the slot till reaching a runnable released after the new one */
+	while ( (loc_Curr != SCHED_NO_RUNNABLE) && (!Sched_IsReleasedBefore(RunnableIdx , loc_Curr)) )
+	{
+		loc_Prev = loc_Curr;
+		loc_Curr = RunnableInfoList[loc_Curr].Next;
+	}
+
+	/* Link the runnable between loc_Prev & loc_Curr */
+	RunnableInfoList[RunnableIdx].Next = loc_Curr;
+	RunnableInfoList[RunnableIdx].Prev = loc_Prev;
+
+	if (loc_Curr != SCHED_NO_RUNNABLE)
+	{
+		RunnableInfoList[loc_Curr].Prev = RunnableIdx;
+	}
+
+	if (loc_Prev != SCHED_NO_RUNNABLE)
+	{
+		RunnableInfoList[loc_Prev].Next = RunnableIdx;
+	}
+	else
+	{
+		Level->Wheel[loc_Slot] = RunnableIdx;
+	}
+	Level->WheelMask |= SCHED_WHEEL_BIT(loc_Slot);
+
+	if ( (Level->ListHead == SCHED_NO_RUNNABLE) || (Sched_IsReleasedBefore(RunnableIdx , Level->ListHead)) )
+	{
+		Level->ListHead = RunnableIdx;
+	}
+}
+
+
+/*
+ * @brief    : Removes a runnable from the timing wheel of its level.
+ * @param[in]: Level - Scheduling level of the runnable.
+ * @param[in]: RunnableIdx - Index of the runnable in RunnableInfoList.
+ * @return   : None.
+ * @details  : The slots are double linked so the runnable is removed directly wherever it is ,
+ *             the nearest release is searched again only when the removed runnable was ListHead.
+ */
+static void Sched_UnlinkRelease(SchedLevel_t *Level , u8 RunnableIdx)
+{
+	u32 loc_Slot = SCHED_WHEEL_SLOT(RunnableInfoList[RunnableIdx].ReleaseTick);
+	u8 loc_Next = RunnableInfoList[RunnableIdx].Next;
+	u8 loc_Prev = RunnableInfoList[RunnableIdx].Prev;
+
+	if (loc_Next != SCHED_NO_RUNNABLE)
+	{
+		RunnableInfoList[loc_Next].Prev = loc_Prev;
+	}
+
+	if (loc_Prev != SCHED_NO_RUNNABLE)
+	{
+		RunnableInfoList[loc_Prev].Next = loc_Next;
+	}
+	else
+	{
+		Level->Wheel[loc_Slot] = loc_Next;
+		if (loc_Next == SCHED_NO_RUNNABLE)
+		{
+			Level->WheelMask &= ~SCHED_WHEEL_BIT(loc_Slot);
+		}
+	}
+
+	if (Level->ListHead == RunnableIdx)
+	{
+		/* The other runnables are released at or after the removed one */
+		Sched_FindListHead(Level , RunnableInfoList[RunnableIdx].ReleaseTick);
+	}
+}
+
+
+/*
+ * @brief    : Compares the releases of two runnables.
+ * @param[in]: FirstIdx - Index of the first runnable in RunnableInfoList.
+ * @param[in]: SecondIdx - Index of the second runnable in RunnableInfoList.
+ * @return   : 1 if the first runnable is released before the second one , 0 otherwise.
+ * @details  : (s32) of the difference keeps the comparison valid when the tick counter wraps around ,
+ *             the lower index is released first at the same tick.
+ */
+static u8 Sched_IsReleasedBefore(u8 FirstIdx , u8 SecondIdx)
+{
+	s32 loc_Diff = (s32)(RunnableInfoList[FirstIdx].ReleaseTick - RunnableInfoList[SecondIdx].ReleaseTick);
+
+	return ( (loc_Diff < 0) || ( (loc_Diff == 0) && (FirstIdx < SecondIdx) ) );
+}
+
+
+/*
+ * @brief    : Searches the runnable with the nearest release tick of a level.
+ * @param[in]: Level - Scheduling level to update its ListHead.
+ * @param[in]: FromTick - Tick at or before the nearest release.
+ * @return   : None.
+ * @details  : WheelMask of the level is rotated so the slot of FromTick is bit 31 , CLZ gives the next slots holding runnables
+ *             in release order. The first head released in the next SCHED_WHEEL_SLOTS ticks is the nearest one ,
+ *             the heads waiting for a later turn of the wheel are compared on the way (Every slot is sorted).
+ */
+static void Sched_FindListHead(SchedLevel_t *Level , u32 FromTick)
+{
+	u32 loc_Start = SCHED_WHEEL_SLOT(FromTick);
+	u32 loc_Mask = Level->WheelMask;
+	u32 loc_Distance;
+	u8 loc_Head;
+	u8 loc_Nearest = SCHED_NO_RUNNABLE;
+
+	/* Rotate left by the start slot (& 31 keeps the right shift defined for slot 0) */
+	loc_Mask = (loc_Mask << loc_Start) | (loc_Mask >> ((SCHED_WHEEL_SLOTS - loc_Start) & (SCHED_WHEEL_SLOTS - 1)));
+
+	while (loc_Mask)
+	{
+		loc_Distance = Core_CountLeadingZeros(loc_Mask);
+		loc_Mask &= ~SCHED_WHEEL_BIT(loc_Distance);
+		loc_Head = Level->Wheel[SCHED_WHEEL_SLOT(loc_Start + loc_Distance)];
+
+		/* Released in this turn of the wheel --> no runnable is released before it */
+		if ( (RunnableInfoList[loc_Head].ReleaseTick - FromTick) < SCHED_WHEEL_SLOTS )
+		{
+			loc_Nearest = loc_Head;
+			break;
+		}
+		if ( (loc_Nearest == SCHED_NO_RUNNABLE) || (Sched_IsReleasedBefore(loc_Head , loc_Nearest)) )
+		{
+			loc_Nearest = loc_Head;
+		}
+	}
+
+	Level->ListHead = loc_Nearest;
+}
+
+
+/*
+ * @brief    : Fills the runtime info of a runnable slot & inserts it in the timing wheel of its level.
+ * @param[in]: RunnableIdx - Index of the slot in RunnableInfoList.
+ * @param[in]: Runnable - Pointer to the runnable configuration.
+ * @param[in]: DelayTicks - Ticks to the first release from the current tick.
+ * @return   : enumError_t - Nok --> Event triggered runnable without a free event bit , the slot is left idle.
+ * @details  : Event triggered runnables are not inserted in the timing wheel , they take a bit of the ready bitmap.
+ *             Called with the interrupts disabled or before Sched_Start , so the pending ticks are stable.
+ */
+static enumError_t Sched_SetupRunnable(u8 RunnableIdx , const Runnable_t *Runnable , u32 DelayTicks)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Ok;
+	RunnableInfo_t *loc_Info = &RunnableInfoList[RunnableIdx];
+	SchedLevel_t *loc_Level;
+	u32 loc_Bit;
+
+	loc_Info->runnable = Runnable;
+	loc_Info->PeriodTicks = Sched_TimeToTicks(Runnable->PeriodicityMs , Runnable->PeriodicityUs);
+	loc_Info->OverrunCount = 0;
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+	loc_Info->BudgetTicks = Sched_TimeToTicks(0 , Runnable->BudgetUs);
+	loc_Info->BudgetOverruns = 0;
+#endif
+#if SCHED_PROFILING == SCHED_ENABLE
+	Sched_ResetRunnableStats(RunnableIdx);
+#endif
+#if SCHED_JITTER == SCHED_ENABLE
+	Sched_ResetJitterHistogram(RunnableIdx);
+#endif
+
+	loc_Info->EventBit = SCHED_NO_EVENT;
+
+	/* Runnables without callback are never inserted so they cost nothing per tick */
+	if (Runnable->cb == NULL_PTR)
+	{
+		loc_Info->State = SCHED_STATE_IDLE;
+	}
+	else if (Runnable->Trigger == SCHED_TRIGGER_EVENT)
+	{
+		if (FreeEventBits == 0)
+		{
+			loc_Info->State = SCHED_STATE_IDLE;
+			Ret_ErrorStatus = Nok;
+		}
+		else
+		{
+			/* Highest free bit --> the runnables set up first are executed first */
+			loc_Bit = Core_CountLeadingZeros(FreeEventBits);
+			FreeEventBits &= ~SCHED_EVENT_MASK(loc_Bit);
+			EventRunnables[loc_Bit] = RunnableIdx;
+			loc_Info->EventBit = (u8)loc_Bit;
+			loc_Info->State = SCHED_STATE_EVENT;
+		}
+	}
+	else
+	{
+		loc_Level = Sched_GetLevel(RunnableIdx);
+		/* From the current tick : The ticks counted but not processed yet by the level are added
+		 * (The high priority level isn't processed while none of its runnables is due) */
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+		loc_Info->ReleaseTick = loc_Level->Tick + ((loc_Level == &HpLevel) ? HpPendingTicks : PendingTicks) + DelayTicks;
+#else
+		loc_Info->ReleaseTick = loc_Level->Tick + PendingTicks + DelayTicks;
+#endif
+		loc_Info->State = SCHED_STATE_WAITING;
+		Sched_InsertRelease(loc_Level , RunnableIdx);
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Releases the slot of a runnable which is not inserted in the timing wheel.
+ * @param[in]: RunnableIdx - Index of the slot in RunnableInfoList.
+ * @return   : None.
+ * @details  : Called with the interrupts disabled. Slots of the pool return to the free list , the static runnables become idle.
+ *             An event triggered runnable gives its bit back & a pending activation is dropped.
+ */
+static void Sched_FreeRunnable(u8 RunnableIdx)
+{
+	u8 loc_Bit = RunnableInfoList[RunnableIdx].EventBit;
+
+	if (loc_Bit != SCHED_NO_EVENT)
+	{
+		Core_AtomicClearBits(&Sched_GetLevel(RunnableIdx)->ReadyMask , SCHED_EVENT_MASK(loc_Bit));
+		FreeEventBits |= SCHED_EVENT_MASK(loc_Bit);
+		RunnableInfoList[RunnableIdx].EventBit = SCHED_NO_EVENT;
+	}
+
+	if (SCHED_IS_POOL_SLOT(RunnableIdx))
+	{
+		RunnableInfoList[RunnableIdx].runnable = NULL_PTR;
+		RunnableInfoList[RunnableIdx].State = SCHED_STATE_FREE;
+		RunnableInfoList[RunnableIdx].Next = FreeListHead;
+		FreeListHead = RunnableIdx;
+	}
+	else
+	{
+		RunnableInfoList[RunnableIdx].State = SCHED_STATE_IDLE;
+	}
+}
+
+
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_PREEMPTIVE_MODE == SCHED_ENABLE)
+/*
+ * @brief    : Gets the ticks remaining to the nearest release of a level.
+ * @param[in]: Level - Scheduling level.
+ * @return   : s32 - Number of ticks to be passed to Sched() to reach the release of ListHead
+ *             (1 --> released by the next tick) , SCHED_NO_RELEASE if no runnable is waiting.
+ */
+static s32 Sched_TicksToRelease(const SchedLevel_t *Level)
+{
+	s32 Ret_Ticks = SCHED_NO_RELEASE;
+
+	if (Level->ListHead != SCHED_NO_RUNNABLE)
+	{
+		Ret_Ticks = (s32)(RunnableInfoList[Level->ListHead].ReleaseTick - Level->Tick) + 1;
+	}
+
+	return Ret_Ticks;
+}
+#endif
+
+
+/*
+ * @brief    : Gets the scheduling level of a runnable by its priority.
+ * @param[in]: RunnableIdx - Index of the runnable in RunnableInfoList.
+ * @return   : SchedLevel_t* - HpLevel for SCHED_PRIORITY_HIGH runnables in preemptive mode , BgLevel for the others.
+ */
+static SchedLevel_t *Sched_GetLevel(u8 RunnableIdx)
+{
+	SchedLevel_t *Ret_Level = &BgLevel;
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	if (RunnableInfoList[RunnableIdx].runnable->Priority == SCHED_PRIORITY_HIGH)
+	{
+		Ret_Level = &HpLevel;
+	}
+#else
+	(void)RunnableIdx;
+#endif
+
+	return Ret_Level;
+}
+
+
+/*
+ * @brief    : Checks if the timing wheel of a level can be modified from the current context.
+ * @param[in]: Level - Scheduling level to be modified.
+ * @return   : u8 - 1 --> Allowed , 0 --> Not allowed.
+ * @details  : The background list is modified by the thread only , the high priority list by the thread
+ *             (with the interrupts disabled) or by PendSV. Interrupt handlers can't modify them.
+ */
+static u8 Sched_IsContextAllowed(const SchedLevel_t *Level)
+{
+	u8 Ret_Allowed = 0;
+	u32 loc_Exception = Core_GetActiveException();
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_DISABLE
+	(void)Level;
+#endif
+
+	if (loc_Exception == 0)
+	{
+		Ret_Allowed = 1;
+	}
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	else if ( (loc_Exception == NVIC_SYS_PENDSV) && (Level == &HpLevel) )
+	{
+		Ret_Allowed = 1;
+	}
+#endif
+	else
+	{
+	}
+
+	return Ret_Allowed;
+}
+
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+/*
+ * @brief    : Counts the passed ticks for the high priority level.
+ * @param[in]: Ticks - Number of passed ticks.
+ * @return   : None.
+ * @details  : Called from the SysTick handler (or with the interrupts disabled) , it requests PendSV
+ *             only when the nearest high priority release is reached so the other ticks cost nothing more.
+ */
+static void Sched_ReleaseHighPriority(u32 Ticks)
+{
+	HpPendingTicks += Ticks;
+	HpTicksToRelease -= (s32)Ticks;
+
+	if (HpTicksToRelease <= 0)
+	{
+		NVIC_SetPending_PendSV();
+	}
+}
+
+
+/*
+ * @brief    : PendSV interrupt handler.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Executes the due & the activated high priority runnables , preempting the background loop of Sched_Start.
+ *             Then publishes the ticks remaining to the next high priority release for the SysTick handler.
+ */
+void PendSV_Handler(void)
+{
+	u32 loc_Ticks;
+
+	/* SysTick preempts PendSV --> take the pending ticks with the interrupts disabled */
+	Core_DisableIRQ();
+	loc_Ticks = HpPendingTicks;
+	HpPendingTicks = 0;
+	Core_EnableIRQ();
+
+	if (loc_Ticks)
+	{
+		Sched(&HpLevel , loc_Ticks);
+	}
+
+	if (HpLevel.ReadyMask)
+	{
+		Sched_DispatchEvents(&HpLevel);
+	}
+
+	Core_DisableIRQ();
+	Sched_PublishHighPriority();
+	Core_EnableIRQ();
+}
+
+
+/*
+ * @brief    : Publishes the ticks remaining to the nearest high priority release for the SysTick handler.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Called with the interrupts disabled after the high priority list is modified.
+ *             Ticks counted but not processed yet are already pending --> subtracted from the published value.
+ */
+static void Sched_PublishHighPriority(void)
+{
+	HpTicksToRelease = Sched_TicksToRelease(&HpLevel) - (s32)HpPendingTicks;
+	if (HpTicksToRelease <= 0)
+	{
+		NVIC_SetPending_PendSV();
+	}
+}
+#endif
+
+
+#if (SCHED_TICKLESS_MODE == SCHED_ENABLE) || (SCHED_JITTER == SCHED_ENABLE) || (SCHED_LOAD_MONITOR == SCHED_ENABLE)
+/*
+ * @brief    : Reads the timings depending on HCLK.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Called by Sched_Init & by RCC when HCLK changes (Clock change callback) , after the SysTick
+ *             recalculated the counts of the tick. Called from a runnable or the main , never during a tickless sleep.
+ */
+static void Sched_UpdateClock(void)
+{
+	STK_GET_ReloadVal(&TickCounts);
+	TickCounts += SCHED_N_COUNT;
+
+#if SCHED_JITTER == SCHED_ENABLE
+	JitterBucketCycles = (RCC_Get_HclkFreq() / SCHED_US_PER_SEC) * SCHED_JITTER_BUCKET_US;
+	if (JitterBucketCycles == 0)
+	{
+		JitterBucketCycles = 1;
+	}
+#endif
+}
+#endif
+
+
+#if SCHED_TICKLESS_MODE == SCHED_ENABLE
+/*
+ * @brief    : Sleeps till the nearest release of the runnables.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Reprograms the SysTick to expire at the release tick of ListHead of the background level (The nearest release)
+ *             & sleeps with WFI. On wake-up (by the SysTick or by any other interrupt) the whole ticks
+ *             passed while sleeping are added to PendingTicks & the SysTick is restored to one tick.
+ *             Interrupts are disabled during the whole sequence so no tick can be lost or counted twice,
+ *             a pending interrupt still wakes the CPU up and its handler runs after enabling them.
+ *             An early wake-up by another interrupt drops the part of the tick elapsed (less than one tick).
+ */
+static void Sched_TicklessIdle(void)
+{
+	u32 loc_SleepTicks;
+	u32 loc_MaxTicks;
+	u32 loc_SleepReload;
+	u32 loc_CurrentVal;
+	u32 loc_ElapsedCounts;
+	u32 loc_PassedTicks;
+	u8  loc_CountFlag;
+#if SCHED_SW_TIMERS == SCHED_ENABLE
+	u32 loc_TimerMs;
+	u32 loc_TimerTicks;
+#endif
+
+	Core_DisableIRQ();
+
+	/* Tick raised , runnable activated or mode requested after checking them --> don't sleep */
+	STK_GET_CountFlag(&loc_CountFlag);
+#if SCHED_MODES == SCHED_ENABLE
+	if ( (PendingTicks == 0) && (loc_CountFlag == 0) && (BgLevel.ReadyMask == 0) && (RequestedMode == CurrentMode) )
+#else
+	if ( (PendingTicks == 0) && (loc_CountFlag == 0) && (BgLevel.ReadyMask == 0) )
+#endif
+	{
+		/* Ticks till the nearest release of both levels , limited by the longest possible sleep */
+		loc_MaxTicks = (STK_MAX_RELOAD_VAL + SCHED_N_COUNT) / TickCounts;
+		loc_SleepTicks = (u32)Sched_TicksToRelease(&BgLevel);
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+		if ( (HpTicksToRelease > 0) && ((u32)HpTicksToRelease < loc_SleepTicks) )
+		{
+			loc_SleepTicks = (u32)HpTicksToRelease;
+		}
+#endif
+#if SCHED_SW_TIMERS == SCHED_ENABLE
+		/* A deadline wake up clears the pending SysTick --> wake up a tick before the expiry ,
+		 * the handler of the next tick expires the timers */
+		if (SwTimer_GetTimeToExpiry(&loc_TimerMs) == Ok)
+		{
+			loc_TimerTicks = Sched_TimeToTicks(loc_TimerMs , 0);
+			loc_TimerTicks = (loc_TimerTicks > 0) ? (loc_TimerTicks - 1) : 0;
+			if (loc_TimerTicks < loc_SleepTicks)
+			{
+				loc_SleepTicks = loc_TimerTicks;
+			}
+		}
+#endif
+#if SCHED_WATCHDOG == SCHED_ENABLE
+		if (loc_MaxTicks > SCHED_WATCHDOG_MAX_SLEEP_TICKS)
+		{
+			loc_MaxTicks = SCHED_WATCHDOG_MAX_SLEEP_TICKS;
+		}
+#endif
+		if (loc_SleepTicks > loc_MaxTicks)
+		{
+			loc_SleepTicks = loc_MaxTicks;
+		}
+
+		if (loc_SleepTicks > 1)
+		{
+			/* The current tick period is partially elapsed --> subtract it to keep the deadline aligned to the ticks */
+			STK_GET_CurrentVal(&loc_CurrentVal);
+			loc_ElapsedCounts = (TickCounts - SCHED_N_COUNT) - loc_CurrentVal;
+			loc_SleepReload = (loc_SleepTicks * TickCounts) - loc_ElapsedCounts - SCHED_N_COUNT;
+			STK_SetReloadVal(loc_SleepReload);
+
+			Core_WaitForInterrupt();
+
+			STK_GET_CountFlag(&loc_CountFlag);
+			STK_GET_CurrentVal(&loc_CurrentVal);
+			if (loc_CountFlag)
+			{
+				/* Woken up by the deadline --> all the ticks passed , its SysTick handler must not add one more */
+				STK_ClearPending();
+				loc_PassedTicks = loc_SleepTicks;
+#if SCHED_JITTER == SCHED_ENABLE
+				/* Counts since the deadline , the counter reloaded the sleep period */
+				Sched_CountJitterTicks(loc_PassedTicks , (loc_CurrentVal == 0) ? 0 : (loc_SleepReload + SCHED_N_COUNT - loc_CurrentVal));
+#endif
+			}
+			else
+			{
+				/* Woken up early by another interrupt --> count the whole ticks passed only */
+				loc_PassedTicks = (loc_ElapsedCounts + (loc_SleepReload - loc_CurrentVal)) / TickCounts;
+#if SCHED_JITTER == SCHED_ENABLE
+				Sched_CountJitterTicks(loc_PassedTicks , (loc_ElapsedCounts + (loc_SleepReload - loc_CurrentVal)) % TickCounts);
+#endif
+			}
+
+			PendingTicks += loc_PassedTicks;
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+			Sched_ReleaseHighPriority(loc_PassedTicks);
+#endif
+
+			/* Back to the normal tick */
+			STK_SetReloadVal(TickCounts - SCHED_N_COUNT);
+		}
+		else
+		{
+			/* Next tick is a release --> sleep till it without reprogramming */
+			Core_WaitForInterrupt();
+		}
+	}
+
+	Core_EnableIRQ();
+}
+#endif
+
+
+/*
+ * @brief    : Callback function for system timer interrupts.
+ * @param[in]: None.
+ * @return   : None.
+ * @details  : Increments the pending ticks counter upon system timer interrupt.
+ */
+static void Tickcb(void)
+{
+#if SCHED_JITTER == SCHED_ENABLE
+	u32 loc_CurrentVal;
+
+	/* The tick started when the counter reached zero , then it reloaded & counted down to the current value */
+	STK_GET_CurrentVal(&loc_CurrentVal);
+	Sched_CountJitterTicks(1 , (loc_CurrentVal == 0) ? 0 : (TickCounts - loc_CurrentVal));
+#endif
+
+	PendingTicks++;
+
+#if SCHED_BUDGET_ENFORCEMENT == SCHED_ENABLE
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	/* A preempted background runnable doesn't consume its budget */
+	Sched_CheckBudget(&HpLevel);
+	if (HpLevel.RunningIdx == SCHED_NO_RUNNABLE)
+#endif
+	{
+		Sched_CheckBudget(&BgLevel);
+	}
+#endif
+
+#if SCHED_PREEMPTIVE_MODE == SCHED_ENABLE
+	Sched_ReleaseHighPriority(1);
+#endif
 }
 
 
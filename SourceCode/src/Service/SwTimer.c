@@ -0,0 +1,557 @@
+/*
+ ============================================================================
+ Name        : SwTimer.c
+ Author      : Farah Mohey
+ Description : Source file for the software timers multiplexed on the SysTick
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+/********************************* Includes **************************************/
+#include "Service/SwTimer.h"
+#include "MCAL/STK.h"
+#include "LIB/CortexM4_Core.h"
+
+/***************************** Definitions *************************************/
+
+/*End of the lists */
+#define SWTIMER_NONE			0xFFFF
+
+/*States of a timer */
+#define SWTIMER_STATE_FREE		0	/* In the free list of the pool */
+#define SWTIMER_STATE_STOPPED	1	/* Created , not in the active list */
+#define SWTIMER_STATE_RUNNING	2	/* In the active list */
+
+/*The time is read in whole milliseconds --> one more millisecond so a timer never expires early */
+#define SWTIMER_ROUND_UP_MS		1
+
+_Static_assert(SWTIMER_MAX_TIMERS < SWTIMER_NONE , "SWTIMER_MAX_TIMERS must be less than 65535");
+
+/***************************** Types Declaration **********************************/
+
+typedef struct
+{
+	SwTimer_CBF_t CallBack;
+	u32 Expiry;		/* Time in milliseconds of the next expiry (STK_GetTimeMs) , the active list is sorted by it */
+	u32 TimeMs;		/* Time of the timer (One-shot) or its period */
+	u16 Next;		/* Next timer in the active list (Or in the free list of the pool) */
+	u16 Prev;		/* Previous timer in the active list to remove it directly */
+	u8  Mode;		/* SWTIMER_ONE_SHOT or SWTIMER_PERIODIC */
+	u8  State;		/* SWTIMER_STATE_FREE , STOPPED or RUNNING */
+} SwTimerInfo_t;
+
+/****************************** Variables **************************************/
+
+static SwTimerInfo_t TimerList[SWTIMER_MAX_TIMERS];
+
+/* Running timers sorted by expiry , the head is the only one checked by the ticks */
+static volatile u16 ActiveHead = SWTIMER_NONE;
+static u16 ActiveTail = SWTIMER_NONE;
+
+/* Free timers of the pool */
+static u16 FreeHead = SWTIMER_NONE;
+
+/************************ Static Function Prototypes ***************************/
+
+static void SwTimer_TickHandler(void);
+static void SwTimer_Insert(u16 TimerIdx);
+static void SwTimer_Unlink(u16 TimerIdx);
+static SwTimerInfo_t *SwTimer_GetTimer(u32 TimerId);
+
+/***************************** Implementation **********************************/
+
+/*
+ * @brief    : Initializes the software timers.
+ * @param[in]: None
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free callback of the SysTick).
+ * @details  : Frees all the timers & adds the handler of the timers to the SysTick interrupt.
+ */
+enumError_t SwTimer_Init(void)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u16 loc_idx;
+	u32 loc_Primask;
+
+	loc_Primask = Core_SaveDisableIRQ();
+
+	ActiveHead = SWTIMER_NONE;
+	ActiveTail = SWTIMER_NONE;
+	FreeHead = SWTIMER_NONE;
+
+	/* Chained from the last one so the timers are taken by the order of their ids */
+	for (loc_idx = SWTIMER_MAX_TIMERS ; loc_idx > 0 ; loc_idx--)
+	{
+		TimerList[loc_idx - 1].State = SWTIMER_STATE_FREE;
+		TimerList[loc_idx - 1].CallBack = NULL_PTR;
+		TimerList[loc_idx - 1].Next = FreeHead;
+		FreeHead = loc_idx - 1;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+
+	Ret_ErrorStatus = STK_AddCallBack(SwTimer_TickHandler);
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Takes a timer from the pool.
+ * @param[in]: TimeMs - Time of the timer (1 to SWTIMER_MAX_TIME_MS).
+ * @param[in]: Mode - SWTIMER_ONE_SHOT or SWTIMER_PERIODIC.
+ * @param[in]: CallBack - Function called at every expiry.
+ * @param[out]: TimerId - Pointer to store the id of the timer in it.
+ * @return   : enumError_t - Error status indicating success or failure (Nok --> No free timer in the pool).
+ * @details  : The timer is created stopped.
+ */
+enumError_t SwTimer_Create(u32 TimeMs , u8 Mode , SwTimer_CBF_t CallBack , u32 *TimerId)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u16 loc_idx;
+	u32 loc_Primask;
+
+	if ( (CallBack == NULL_PTR) || (TimerId == NULL_PTR) )
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else if ( (TimeMs == 0) || (TimeMs > SWTIMER_MAX_TIME_MS) || (Mode > SWTIMER_PERIODIC) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		loc_Primask = Core_SaveDisableIRQ();
+
+		loc_idx = FreeHead;
+		if (loc_idx == SWTIMER_NONE)
+		{
+			Ret_ErrorStatus = Nok;
+		}
+		else
+		{
+			FreeHead = TimerList[loc_idx].Next;
+
+			TimerList[loc_idx].CallBack = CallBack;
+			TimerList[loc_idx].TimeMs = TimeMs;
+			TimerList[loc_idx].Mode = Mode;
+			TimerList[loc_idx].State = SWTIMER_STATE_STOPPED;
+
+			*TimerId = loc_idx;
+			Ret_ErrorStatus = Ok;
+		}
+
+		Core_RestoreIRQ(loc_Primask);
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Returns a timer to the pool.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : A running timer is stopped first , the id must not be used anymore.
+ */
+enumError_t SwTimer_Delete(u32 TimerId)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer;
+	u32 loc_Primask;
+
+	loc_Primask = Core_SaveDisableIRQ();
+
+	loc_Timer = SwTimer_GetTimer(TimerId);
+	if (loc_Timer == NULL_PTR)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		if (loc_Timer->State == SWTIMER_STATE_RUNNING)
+		{
+			SwTimer_Unlink((u16)TimerId);
+		}
+
+		loc_Timer->State = SWTIMER_STATE_FREE;
+		loc_Timer->CallBack = NULL_PTR;
+		loc_Timer->Next = FreeHead;
+		FreeHead = (u16)TimerId;
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Starts a stopped timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : A running timer keeps its expiry.
+ */
+enumError_t SwTimer_Start(u32 TimerId)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer;
+	u32 loc_Primask;
+
+	loc_Primask = Core_SaveDisableIRQ();
+
+	loc_Timer = SwTimer_GetTimer(TimerId);
+	if (loc_Timer == NULL_PTR)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		if (loc_Timer->State == SWTIMER_STATE_STOPPED)
+		{
+			loc_Timer->Expiry = STK_GetTimeMs() + loc_Timer->TimeMs + SWTIMER_ROUND_UP_MS;
+			loc_Timer->State = SWTIMER_STATE_RUNNING;
+			SwTimer_Insert((u16)TimerId);
+		}
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Stops a timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Its callback is not called anymore , stopping a stopped timer has no effect.
+ */
+enumError_t SwTimer_Stop(u32 TimerId)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer;
+	u32 loc_Primask;
+
+	loc_Primask = Core_SaveDisableIRQ();
+
+	loc_Timer = SwTimer_GetTimer(TimerId);
+	if (loc_Timer == NULL_PTR)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		if (loc_Timer->State == SWTIMER_STATE_RUNNING)
+		{
+			SwTimer_Unlink((u16)TimerId);
+			loc_Timer->State = SWTIMER_STATE_STOPPED;
+		}
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Starts a timer again from now whether it is running or stopped.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : The timers restarted with the same time have the latest expiry , so they are inserted
+ *             from the tail of the active list with a few comparisons whatever the number of timers.
+ */
+enumError_t SwTimer_Restart(u32 TimerId)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer;
+	u32 loc_Primask;
+
+	loc_Primask = Core_SaveDisableIRQ();
+
+	loc_Timer = SwTimer_GetTimer(TimerId);
+	if (loc_Timer == NULL_PTR)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		if (loc_Timer->State == SWTIMER_STATE_RUNNING)
+		{
+			SwTimer_Unlink((u16)TimerId);
+		}
+
+		loc_Timer->Expiry = STK_GetTimeMs() + loc_Timer->TimeMs + SWTIMER_ROUND_UP_MS;
+		loc_Timer->State = SWTIMER_STATE_RUNNING;
+		SwTimer_Insert((u16)TimerId);
+
+		Ret_ErrorStatus = Ok;
+	}
+
+	Core_RestoreIRQ(loc_Primask);
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Changes the time of a timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @param[in]: TimeMs - New time of the timer (1 to SWTIMER_MAX_TIME_MS).
+ * @return   : enumError_t - Error status indicating success or failure.
+ * @details  : Used from the next start or period , the current expiry of a running timer doesn't change.
+ */
+enumError_t SwTimer_SetTime(u32 TimerId , u32 TimeMs)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer;
+	u32 loc_Primask;
+
+	if ( (TimeMs == 0) || (TimeMs > SWTIMER_MAX_TIME_MS) )
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		loc_Primask = Core_SaveDisableIRQ();
+
+		loc_Timer = SwTimer_GetTimer(TimerId);
+		if (loc_Timer == NULL_PTR)
+		{
+			Ret_ErrorStatus = WrongInput;
+		}
+		else
+		{
+			loc_Timer->TimeMs = TimeMs;
+			Ret_ErrorStatus = Ok;
+		}
+
+		Core_RestoreIRQ(loc_Primask);
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets whether a timer is running.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @param[out]: Running - Pointer to store 1 for a running timer , 0 for a stopped one.
+ * @return   : enumError_t - Error status indicating success or failure.
+ */
+enumError_t SwTimer_IsRunning(u32 TimerId , u8 *Running)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	SwTimerInfo_t *loc_Timer = SwTimer_GetTimer(TimerId);
+
+	if (Running == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else if (loc_Timer == NULL_PTR)
+	{
+		Ret_ErrorStatus = WrongInput;
+	}
+	else
+	{
+		*Running = (loc_Timer->State == SWTIMER_STATE_RUNNING) ? 1 : 0;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/*
+ * @brief    : Gets the time till the nearest expiry of the running timers.
+ * @param[out]: TimeMs - Pointer to store the milliseconds till the nearest expiry in it (0 --> Already expired).
+ * @return   : enumError_t - Ok , Nok (No timer is running).
+ * @details  : Only reads the head of the active list , so the interrupts are not disabled.
+ */
+enumError_t SwTimer_GetTimeToExpiry(u32 *TimeMs)
+{
+	/*Variable to store error status to be returned at the end of the function */
+	u32 Ret_ErrorStatus = Nok;
+	u16 loc_Head = ActiveHead;
+	s32 loc_Remaining;
+
+	if (TimeMs == NULL_PTR)
+	{
+		Ret_ErrorStatus = NullPointer;
+	}
+	else if (loc_Head == SWTIMER_NONE)
+	{
+		Ret_ErrorStatus = Nok;
+	}
+	else
+	{
+		loc_Remaining = (s32)(TimerList[loc_Head].Expiry - STK_GetTimeMs());
+		*TimeMs = (loc_Remaining > 0) ? (u32)loc_Remaining : 0;
+		Ret_ErrorStatus = Ok;
+	}
+
+	return Ret_ErrorStatus;
+}
+
+
+/************************ Implementation of Static Functions ***************************/
+
+/*
+ * @brief    : Expires the timers from the SysTick interrupt.
+ * @param[in]: None
+ * @return   : None
+ * @details  : Only the head of the active list is compared with the time. Every expired timer is removed
+ *             (A periodic one is inserted again at its next expiry) with the interrupts disabled , then its
+ *             callback is called with their state restored so it can start , stop or delete any timer.
+ */
+static void SwTimer_TickHandler(void)
+{
+	u32 loc_Now = STK_GetTimeMs();
+	u16 loc_idx;
+	SwTimerInfo_t *loc_Timer;
+	SwTimer_CBF_t loc_CallBack;
+	u32 loc_Primask;
+
+	while ( (ActiveHead != SWTIMER_NONE) && ((s32)(loc_Now - TimerList[ActiveHead].Expiry) >= 0) )
+	{
+		loc_CallBack = NULL_PTR;
+
+		loc_Primask = Core_SaveDisableIRQ();
+
+		/* Checked again , a higher priority interrupt may have stopped it meanwhile */
+		loc_idx = ActiveHead;
+		if ( (loc_idx != SWTIMER_NONE) && ((s32)(loc_Now - TimerList[loc_idx].Expiry) >= 0) )
+		{
+			loc_Timer = &TimerList[loc_idx];
+			SwTimer_Unlink(loc_idx);
+
+			if (loc_Timer->Mode == SWTIMER_PERIODIC)
+			{
+				/* Keep the phase , the periods missed by a late tick are skipped */
+				loc_Timer->Expiry += loc_Timer->TimeMs;
+				if ((s32)(loc_Now - loc_Timer->Expiry) >= 0)
+				{
+					loc_Timer->Expiry += ( ((loc_Now - loc_Timer->Expiry) / loc_Timer->TimeMs) + 1 ) * loc_Timer->TimeMs;
+				}
+				SwTimer_Insert(loc_idx);
+			}
+			else
+			{
+				loc_Timer->State = SWTIMER_STATE_STOPPED;
+			}
+
+			loc_CallBack = loc_Timer->CallBack;
+		}
+
+		Core_RestoreIRQ(loc_Primask);
+
+		if (loc_CallBack)
+		{
+			loc_CallBack(loc_idx);
+		}
+	}
+}
+
+
+/*
+ * @brief    : Inserts a timer in the active list.
+ * @param[in]: TimerIdx - Index of the timer in TimerList , its expiry is set.
+ * @return   : None
+ * @details  : Walks from the tail since a timer (Re)started now mostly expires after the running ones.
+ *             Timers of the same expiry are kept by their order of start. Called with the interrupts disabled.
+ */
+static void SwTimer_Insert(u16 TimerIdx)
+{
+	u32 loc_Expiry = TimerList[TimerIdx].Expiry;
+	u16 loc_Prev = ActiveTail;
+
+	/* Walk back till reaching a timer expiring before or with the new one */
+	while ( (loc_Prev != SWTIMER_NONE) && ((s32)(TimerList[loc_Prev].Expiry - loc_Expiry) > 0) )
+	{
+		loc_Prev = TimerList[loc_Prev].Prev;
+	}
+
+	TimerList[TimerIdx].Prev = loc_Prev;
+	if (loc_Prev == SWTIMER_NONE)
+	{
+		TimerList[TimerIdx].Next = ActiveHead;
+		ActiveHead = TimerIdx;
+	}
+	else
+	{
+		TimerList[TimerIdx].Next = TimerList[loc_Prev].Next;
+		TimerList[loc_Prev].Next = TimerIdx;
+	}
+
+	if (TimerList[TimerIdx].Next == SWTIMER_NONE)
+	{
+		ActiveTail = TimerIdx;
+	}
+	else
+	{
+		TimerList[TimerList[TimerIdx].Next].Prev = TimerIdx;
+	}
+}
+
+
+/*
+ * @brief    : Removes a timer from the active list.
+ * @param[in]: TimerIdx - Index of the timer in TimerList , it must be in the list.
+ * @return   : None
+ * @details  : Called with the interrupts disabled.
+ */
+static void SwTimer_Unlink(u16 TimerIdx)
+{
+	u16 loc_Prev = TimerList[TimerIdx].Prev;
+	u16 loc_Next = TimerList[TimerIdx].Next;
+
+	if (loc_Prev == SWTIMER_NONE)
+	{
+		ActiveHead = loc_Next;
+	}
+	else
+	{
+		TimerList[loc_Prev].Next = loc_Next;
+	}
+
+	if (loc_Next == SWTIMER_NONE)
+	{
+		ActiveTail = loc_Prev;
+	}
+	else
+	{
+		TimerList[loc_Next].Prev = loc_Prev;
+	}
+}
+
+
+/*
+ * @brief    : Gets a created timer.
+ * @param[in]: TimerId - Id of the timer given by SwTimer_Create.
+ * @return   : SwTimerInfo_t* - The timer , NULL_PTR for a wrong or free id.
+ */
+static SwTimerInfo_t *SwTimer_GetTimer(u32 TimerId)
+{
+	SwTimerInfo_t *Ret_Timer = NULL_PTR;
+
+	if ( (TimerId < SWTIMER_MAX_TIMERS) && (TimerList[TimerId].State != SWTIMER_STATE_FREE) )
+	{
+		Ret_Timer = &TimerList[TimerId];
+	}
+
+	return Ret_Timer;
+}
@@ -32,6 +32,7 @@
 #include "diag/trace.h"
 #include "MCAL/RCC.h"
 #include "MCAL/GPIO.h"
+#include "CFG/GPIO_Image_Cfg.h"
 #include "HAL/LED.h"
 #include "MCAL/STK.h"
 
@@ -128,7 +129,8 @@ int main(int argc, char* argv[])
 	RCC_Enable_AHB1_Peripheral(AHB1_GPIOB);
 	RCC_Enable_AHB1_Peripheral(AHB1_GPIOC);
 
-	LED_Init();
+	/*LEDs & switches from the images generated by tools/GPIO_Image.py (In place of LED_Init & SWITCH_Init) */
+	GPIO_InitImages(GPIO_Images , GPIO_IMAGE_PORTS);
 /*
 	STK_SetConfig(STK_AHB_8_ENB_INT);
 	STK_SetCallBack(ToggleLEd);
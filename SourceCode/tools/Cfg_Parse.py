@@ -0,0 +1,86 @@
+"""
+ ============================================================================
+ Name        : Cfg_Parse.py
+ Author      : Farah Mohey
+ Description : Readers of the C configuration files shared by the build time tools
+ Created	 : 28-Apr-24
+ ============================================================================
+
+ Used by tools/Sched_Tick.py , tools/Sched_Offsets.py & tools/GPIO_Image.py
+ (Imported from the directory of the tools , not run by itself).
+
+ The configuration is read as written in the files : The comments are removed ,
+ the tables are the designated initializers ([Index] = {.Field = Value , ...})
+ of the arrays & the values are kept as text for the tools to evaluate them.
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+US_PER_MS = 1000
+
+
+def strip_comments(text):
+    """Returns text without the /* */ & // comments"""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def read_source(path):
+    """Returns the text of a source without its comments"""
+    with open(path) as source:
+        return strip_comments(source.read())
+
+
+def read_define(path, name):
+    """Returns the integer value of the #define name of a header , stops when it's missing"""
+    match = re.search(r"^\s*#define\s+%s\s+(\w+)" % name, read_source(path), flags=re.M)
+    if not match:
+        sys.exit("%s not found in %s" % (name, os.path.relpath(path, ROOT)))
+    return int(match.group(1), 0)
+
+
+def read_enum(path, last):
+    """Returns the names of the first enum of a header before its counter last (e.g. _MaxRunnables)"""
+    body = read_source(path)
+    body = body[body.index("{") + 1:body.index("}")]
+    return [name.strip() for name in body.split(",") if name.strip() and name.strip() != last]
+
+
+def read_entries(body):
+    """Returns the [Index] = {.Field = Value , ...} entries of the initializer of a table as (Index , {Field : Value})"""
+    entries = []
+    for idx, fields in re.findall(r"(?<!\w)\[\s*(\w+)\s*\]\s*=\s*\{(.*?)\}", body, flags=re.S):
+        entries.append((idx, dict((key, value.strip()) for key, value in re.findall(r"\.(\w+)\s*=\s*(\"[^\"]*\"|[^,]+)", fields))))
+    return entries
+
+
+def read_table(path, name):
+    """Returns the entries of the table name of a source , stops when it's missing"""
+    match = re.search(r"\b%s\s*\[[^\]]*\]\s*=\s*\{(.*?)\n\s*\}\s*;" % name, read_source(path), flags=re.S)
+    if not match:
+        sys.exit("%s not found in %s" % (name, os.path.relpath(path, ROOT)))
+    return read_entries(match.group(1))
+
+
+def read_runnables(entries):
+    """Returns the Runnable_t entries of a table by their index with their times in microseconds"""
+    runnables = {}
+    for idx, entry in entries:
+        field = lambda name: int(entry.get(name, "0"), 0)
+        runnables[idx] = {
+            "name": entry.get("Name", '"%s"' % idx).strip('"'),
+            "period_us": field("PeriodicityMs") * US_PER_MS + field("PeriodicityUs"),
+            "delay_us": field("DelayTimeMs") * US_PER_MS + field("DelayTimeUs"),
+            "cb": entry.get("cb", "NULL_PTR"),
+            "event": entry.get("Trigger", "") == "SCHED_TRIGGER_EVENT",
+        }
+    return runnables
+
+
+def has_callback(runnable):
+    """A runnable without callback is never scheduled"""
+    return runnable["cb"] not in ("NULL_PTR", "NULL", "0")
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+"""
+ ============================================================================
+ Name        : GPIO_Image.py
+ Author      : Farah Mohey
+ Description : Build time generator of the register images of the GPIO ports
+ Created	 : 28-Apr-24
+ ============================================================================
+
+ Reads the pins of LEDS[] (src/CFG/LED_Cfg.c) & SWITCHES[] (src/CFG/SWITCH_Cfg.c)
+ & writes the final MODER , OTYPER , OSPEEDR , PUPDR , AFRL , AFRH of every used
+ port with the initial levels of the LEDs (BSRR) in include/CFG/GPIO_Image_Cfg.h ,
+ so GPIO_InitImages configures a port by a handful of stores without any mask
+ or shift at runtime (In place of LED_Init & SWITCH_Init).
+
+ The LEDs are push-pull outputs of GPIO_HIGH_SPEED & the switches inputs of
+ their Connection with GPIO_LOW_SPEED like LED_Init & SWITCH_Init. AFRL & AFRH
+ take the .AltFunc of the entries (GPIO_AF0 when it's not given , like LED_Init
+ & SWITCH_Init) for the pins of the GPIO_AF_* moods (AF0 for the others) like
+ GPIO_InitPin. The pins out of the tables keep the reset values of the STM32F401 ,
+ so the debug pins (PA13 PA14 PA15 PB3 PB4) stay SWD/JTAG unless a table takes
+ them (Warned).
+ A pin used twice (e.g. by a LED & a switch) stops the generation.
+
+ The header lists the pins the images are generated from (GPIO_IMAGE_PINS) ,
+ src/CFG/GPIO_Image_Cfg.c checks them against the images at compile time (Pin ,
+ mood , speed , alternate function & level of every pin in the registers of its
+ port , no pin used twice) so a wrong or edited header doesn't compile.
+
+ --check regenerates the header in memory & fails (Exit 1 with the diff) when
+ it differs from the committed one , so a change of a port , pin , mood or level
+ of the tables that wasn't regenerated is caught. The compiler can't read
+ LEDS[] & SWITCHES[] , add it as a pre-build step of the target project.
+
+ Usage : python3 tools/GPIO_Image.py [--dry-run | --check]
+"""
+
+import argparse
+import difflib
+import os
+import re
+import sys
+
+from Cfg_Parse import ROOT, read_source, read_table
+
+LED_CFG = os.path.join(ROOT, "src", "CFG", "LED_Cfg.c")
+SWITCH_CFG = os.path.join(ROOT, "src", "CFG", "SWITCH_Cfg.c")
+MACRO_HEADERS = [os.path.join(ROOT, "include", *path) for path in
+                 (("LIB", "Masks.h"), ("MCAL", "GPIO.h"), ("HAL", "LED.h"))]
+OUT_FILE = os.path.join(ROOT, "include", "CFG", "GPIO_Image_Cfg.h")
+
+PORTS = "ABCDEH"
+REGISTERS = ("MODER", "OTYPER", "OSPEEDR", "PUPDR", "AFRL", "AFRH")
+
+# Reset values of the STM32F401 (RM0368) , the other ports & registers reset to 0
+RESET_VALUES = {
+    "A": {"MODER": 0xA8000000, "OSPEEDR": 0x0C000000, "PUPDR": 0x64000000},
+    "B": {"MODER": 0x00000280, "OSPEEDR": 0x000000C0, "PUPDR": 0x00000100},
+}
+DEBUG_PINS = {("A", 13), ("A", 14), ("A", 15), ("B", 3), ("B", 4)}
+
+# Fields of the Mood of GPIO.h (Same masks as src/MCAL/GPIO.c)
+MODE_MASK = 0x03
+OUT_TYPE_MASK, OUT_TYPE_SHIFT = 0x04, 2
+PULL_TYPE_MASK, PULL_TYPE_SHIFT = 0x18, 3
+MODE_AF = 2
+
+
+def read_macros():
+    macros = {}
+    for path in MACRO_HEADERS:
+        for name, value in re.findall(r"^\s*#define\s+(\w+)[ \t]+([^\n]+)", read_source(path), flags=re.M):
+            macros[name] = value.strip()
+    return macros
+
+
+def evaluate(token, macros):
+    token = token.strip()
+    seen = set()
+    while token in macros and token not in seen:
+        seen.add(token)
+        token = macros[token]
+    try:
+        return int(token, 0)
+    except ValueError:
+        sys.exit("Can't evaluate '%s' , use the macros of GPIO.h , LED.h & Masks.h" % token)
+
+
+def port_letter(entry, owner):
+    match = re.fullmatch(r"GPIO_PORT([A-H])", entry.get("Port", ""))
+    if not match or match.group(1) not in PORTS:
+        sys.exit("%s : port '%s' is not GPIO_PORTA B C D E H" % (owner, entry.get("Port")))
+    return match.group(1)
+
+
+def read_pins(macros):
+    pins = []
+    for idx, entry in read_table(LED_CFG, "LEDS"):
+        level = evaluate(entry["Connection"], macros) ^ evaluate(entry["Status"], macros)
+        pins.append(dict(read_fields(entry, "GPIO_OUTPUT_PP", "GPIO_HIGH_SPEED", macros),
+                         owner="LEDS[%s]" % idx, port=port_letter(entry, idx), level=level))
+    for idx, entry in read_table(SWITCH_CFG, "SWITCHES"):
+        pins.append(dict(read_fields(entry, entry["Connection"], "GPIO_LOW_SPEED", macros),
+                         owner="SWITCHES[%s]" % idx, port=port_letter(entry, idx), level=None))
+    return pins
+
+
+def read_fields(entry, mood, speed, macros):
+    """Returns the values of the pin , mood , speed & alternate function of an entry with their names (For GPIO_IMAGE_PINS)"""
+    names = {"pin": entry["Pin"], "mood": mood, "speed": speed, "altfunc": entry.get("AltFunc", "GPIO_AF0")}
+    fields = dict((key, evaluate(name, macros)) for key, name in names.items())
+    fields["names"] = names
+    return fields
+
+
+def check_pins(pins, macros):
+    owners = {}
+    errors = []
+    for pin in pins:
+        key = (pin["port"], pin["pin"])
+        if not 0 <= pin["pin"] <= 15:
+            errors.append("%s : pin %d out of GPIO_PIN0 --> GPIO_PIN15" % (pin["owner"], pin["pin"]))
+        elif key in owners:
+            errors.append("P%s%d used by %s & %s" % (key[0], key[1], owners[key], pin["owner"]))
+        else:
+            owners[key] = pin["owner"]
+        if not 0 <= pin["altfunc"] <= 15:
+            errors.append("%s : AltFunc %d out of GPIO_AF0 --> GPIO_AF15" % (pin["owner"], pin["altfunc"]))
+        if pin["level"] not in (None, evaluate("GPIO_SET_PIN", macros), evaluate("GPIO_RESET_PIN", macros)):
+            errors.append("%s : Connection ^ Status is not LED_ON or LED_OFF" % pin["owner"])
+        if key in DEBUG_PINS:
+            print("Warning : %s takes the debug pin P%s%d" % (pin["owner"], key[0], key[1]))
+    if errors:
+        sys.exit("\n".join(errors))
+
+
+def build_images(pins):
+    images = {}
+    for pin in sorted(pins, key=lambda pin: (PORTS.index(pin["port"]), pin["pin"])):
+        image = images.setdefault(pin["port"], dict(dict.fromkeys(REGISTERS + ("BSRR",), 0), **RESET_VALUES.get(pin["port"], {})))
+        num, shift = pin["pin"], pin["pin"] * 2
+        fields = {"MODER": (pin["mood"] & MODE_MASK, 2),
+                  "OTYPER": ((pin["mood"] & OUT_TYPE_MASK) >> OUT_TYPE_SHIFT, 1),
+                  "OSPEEDR": (pin["speed"], 2),
+                  "PUPDR": ((pin["mood"] & PULL_TYPE_MASK) >> PULL_TYPE_SHIFT, 2),
+                  "AFRL" if num < 8 else "AFRH": (pin["altfunc"] if pin["mood"] & MODE_MASK == MODE_AF else 0, 4)}
+        for register, (value, width) in fields.items():
+            position = {1: num, 2: shift, 4: (num % 8) * 4}[width]
+            image[register] = (image[register] & ~(((1 << width) - 1) << position)) | (value << position)
+        if pin["level"] is not None:
+            image["BSRR"] |= pin["level"] << num
+    return images
+
+
+def define(name, value, column=40):
+    """Returns a #define with its value aligned by tabs (4 columns) at column"""
+    line = "#define " + name
+    return line + "\t" * max(1, -(-(column - len(line)) // 4)) + value + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="GPIO register images generator")
+    parser.add_argument("--out", default=OUT_FILE, help="generated header")
+    modes = parser.add_mutually_exclusive_group()
+    modes.add_argument("--dry-run", action="store_true", help="print the images without writing the header")
+    modes.add_argument("--check", action="store_true", help="fail if the header isn't the one generated from the tables")
+    args = parser.parse_args()
+
+    macros = read_macros()
+    pins = read_pins(macros)
+    check_pins(pins, macros)
+    images = build_images(pins)
+
+    ports = sorted(images, key=PORTS.index)
+    registers = []
+    for index, port in enumerate(ports):
+        image = images[port]
+        if not args.check:
+            print("Port %s : %s" % (port, " ".join("%s=0x%08X" % (register, image[register]) for register in REGISTERS + ("BSRR",))))
+        registers.append(define("GPIO_IMAGE_PORT%d" % index, "GPIO_PORT%s" % port) +
+                         "".join(define("GPIO_IMAGE_PORT%d_%s" % (index, register), "0x%08X" % image[register])
+                                 for register in REGISTERS + ("BSRR",)))
+
+    entries = ["\tEntry(Arg , %d , %s , %s , %s , %s , %d)\t/*%s*/" % (ports.index(pin["port"]), pin["names"]["pin"], pin["names"]["mood"],
+                                                                    pin["names"]["speed"], pin["names"]["altfunc"], pin["level"] or 0, pin["owner"])
+               for pin in sorted(pins, key=lambda pin: (PORTS.index(pin["port"]), pin["pin"]))]
+
+    header = HEADER % (len(images), sum(pin["level"] is not None for pin in pins),
+                       sum(pin["level"] is None for pin in pins), "\n".join(registers),
+                       " , \\\n".join("\tGPIO_IMAGE_ROW(%d)" % index for index in range(len(ports))),
+                       " \\\n".join(entries))
+
+    if args.check:
+        current = open(args.out).read() if os.path.exists(args.out) else ""
+        if current != header:
+            sys.stdout.writelines(difflib.unified_diff(current.splitlines(True), header.splitlines(True),
+                                                       os.path.relpath(args.out, ROOT), "generated"))
+            sys.exit("%s is stale , run python3 tools/GPIO_Image.py" % os.path.relpath(args.out, ROOT))
+    elif not args.dry_run:
+        with open(args.out, "w") as out:
+            out.write(header)
+        print("Written %s" % os.path.relpath(args.out, ROOT))
+
+
+HEADER = """/*
+ ============================================================================
+ Name        : GPIO_Image_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file of the register images of the GPIO ports
+ Created	 : 28-Apr-24
+ ============================================================================
+ */
+
+#ifndef CFG_GPIO_IMAGE_CFG_H_
+#define CFG_GPIO_IMAGE_CFG_H_
+
+/* Generated by tools/GPIO_Image.py from LEDS[] & SWITCHES[] , don't edit it manually */
+
+/*******************************  Definitions  *********************************/
+
+/* Number of ports in GPIO_IMAGE_TABLE */
+#define GPIO_IMAGE_PORTS			%d
+
+/* Number of LEDs & switches the images are generated from (Checked against LED_Cfg.h & SWITCH_Cfg.h) */
+#define GPIO_IMAGE_LEDS				%d
+#define GPIO_IMAGE_SWITCHES			%d
+
+/* Images of the ports : Port , MODER , OTYPER , OSPEEDR , PUPDR , AFRL , AFRH , BSRR */
+%s
+/* Initializer of the GPIO_Image_t of the ports (GPIO_IMAGE_ROW of src/CFG/GPIO_Image_Cfg.c) */
+#define GPIO_IMAGE_TABLE \\
+%s
+
+/* Pins the images are generated from : Entry(Arg , Index of the port in GPIO_IMAGE_TABLE , Pin , Mood , Speed , AltFunc , Level)
+ * Level is the initial level of a LED (0 for the switches) , checked against the images in src/CFG/GPIO_Image_Cfg.c */
+#define GPIO_IMAGE_PINS(Entry , Arg) \\
+%s
+
+
+
+#endif /* CFG_GPIO_IMAGE_CFG_H_ */
+"""
+
+
+if __name__ == "__main__":
+    main()
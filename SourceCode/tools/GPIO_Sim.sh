@@ -0,0 +1,32 @@
+#!/bin/sh
+# ============================================================================
+# Name        : GPIO_Sim.sh
+# Author      : Farah Mohey
+# Description : Builds & runs the test of the batch GPIO initialization on fake registers
+# Created	  : 28-Apr-24
+# ============================================================================
+#
+# Compiles the real src/MCAL/GPIO.c for the host (CORE_SIM , the ports of GPIO.h are in the fake registers
+# of src/SIM/GPIO_Sim.c) with the configuration of LEDS[] , SWITCHES[] & the generated images & runs
+# src/SIM/GPIO_Sim.c : GPIO_InitPins against GPIO_InitPin per pin & GPIO_InitImages against the tables.
+#
+# Usage : sh tools/GPIO_Sim.sh
+#
+# Environment :
+#   GPIO_SIM_OUT          Output executable (build/GPIO_Sim)
+#   CC , CFLAGS           Host compiler & flags (cc , -O2)
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+OUT=${GPIO_SIM_OUT:-$ROOT/build/GPIO_Sim}
+
+mkdir -p "$(dirname "$OUT")"
+
+${CC:-cc} ${CFLAGS:--O2} -std=gnu11 -DCORE_SIM -I"$ROOT/include" \
+	"$ROOT/src/MCAL/GPIO.c" "$ROOT/src/SIM/GPIO_Sim.c" \
+	"$ROOT/src/CFG/LED_Cfg.c" "$ROOT/src/CFG/SWITCH_Cfg.c" "$ROOT/src/CFG/GPIO_Image_Cfg.c" \
+	-o "$OUT"
+
+"$OUT" "$@"
@@ -0,0 +1,32 @@
+#!/bin/sh
+# ============================================================================
+# Name        : RingBuffer_Sim.sh
+# Author      : Farah Mohey
+# Description : Builds & runs the two thread stress test & throughput of the ring buffer
+# Created	  : 28-Apr-24
+# ============================================================================
+#
+# Compiles the real src/Service/RingBuffer.c for the host with the emulated core of src/SIM (CORE_SIM ,
+# Core_DataMemoryBarrier is a full fence of the host) & src/SIM/RingBuffer_Sim.c running the producer
+# & the consumer in two threads. Fails if an element is lost , duplicated , reordered or torn.
+#
+# Usage : sh tools/RingBuffer_Sim.sh [Millions]     (Default 4 M elements per API pair)
+#
+# Environment :
+#   RINGBUFFER_SIM_OUT    Output executable (build/RingBuffer_Sim)
+#   CC , CFLAGS           Host compiler & flags (cc , -O2)
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+OUT=${RINGBUFFER_SIM_OUT:-$ROOT/build/RingBuffer_Sim}
+
+mkdir -p "$(dirname "$OUT")"
+
+${CC:-cc} ${CFLAGS:--O2} -std=gnu11 -DCORE_SIM -pthread -I"$ROOT/include/SIM" -I"$ROOT/include" \
+	"$ROOT/src/Service/RingBuffer.c" "$ROOT/src/SIM/RingBuffer_Sim.c" \
+	"$ROOT/src/SIM/Core_Sim.c" "$ROOT/src/SIM/STK_Sim.c" "$ROOT/src/SIM/DWT_Sim.c" \
+	-o "$OUT"
+
+"$OUT" "$@"
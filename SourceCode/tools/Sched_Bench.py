@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+ ============================================================================
+ Name        : Sched_Bench.py
+ Author      : Farah Mohey
+ Description : Host benchmark of the cost of a scheduler tick against _MaxRunnables
+ Created	 : 26-Apr-24
+ ============================================================================
+
+ Generates for every size a RunnableList of that many runnables (Periods of
+ 10 ms to 1 s spread over the ticks , so most ticks release nothing like a real
+ application) in build/Sched_Bench & simulates it by tools/Sched_Sim.sh.
+
+ The simulator is built with SCHED_TICK_PROFILING enabled (Every other option
+ of CFG/Sched_Cfg.h disabled) & DWT_SIM_HOST_CYCLES , so Sched_GetTickStats
+ returns the host cycles spent inside Sched() : The timing wheel , the dispatch
+ & the stubs of the released runnables , without the simulated SysTick & idle
+ loop around it. The average stays flat with the size when the cost of a tick
+ depends only on the runnables released in it (The releases per tick grow with
+ the size). Every size is simulated --runs times & the lowest average is
+ kept to filter the noise of the host. The longest tick is not reported , on
+ the host it is the one preempted by the host OS.
+
+ On the target the same numbers are read by Sched_GetTickStats with
+ SCHED_TICK_PROFILING enabled in the application build.
+
+ Usage : python3 tools/Sched_Bench.py [--sizes 1 8 16 32 64 128] [--hours 1] [--runs 3]
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+OUT_DIR = os.path.join(ROOT, "build", "Sched_Bench")
+SCHED_CFG = os.path.join(ROOT, "include", "CFG", "Sched_Cfg.h")
+
+# Periods of the generated runnables in milliseconds (Multiples of the tick)
+PERIODS_MS = (10, 20, 50, 100, 200, 500, 1000)
+COST_CYCLES = (100, 300)
+
+ENUM_H = """#ifndef CFG_RUNNABLESLIST_CFG_H_
+#define CFG_RUNNABLESLIST_CFG_H_
+
+/* Generated by tools/Sched_Bench.py */
+
+typedef enum
+{
+%s
+	_MaxRunnables
+}RunnablesList_t;
+
+#endif /* CFG_RUNNABLESLIST_CFG_H_ */
+"""
+
+LIST_C = """/* Generated by tools/Sched_Bench.py */
+
+#include "CFG/RunnablesList_Cfg.h"
+#include "SIM/Sched_Sim.h"
+
+%s
+
+const  Runnable_t RunnableList[_MaxRunnables] =
+{
+%s
+};
+
+const SchedSim_Cost_t SchedSimCostList[_MaxRunnables] =
+{
+%s
+};
+"""
+
+
+def write(path, text):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w") as out:
+        out.write(text)
+
+
+def bench_sched_cfg():
+    """Returns CFG/Sched_Cfg.h with only SCHED_TICK_PROFILING enabled"""
+    with open(SCHED_CFG) as cfg:
+        text = cfg.read()
+    text = re.sub(r"(#define\s+SCHED_\w+\s+)SCHED_ENABLE\b", r"\1SCHED_DISABLE", text)
+    text, found = re.subn(r"(#define\s+SCHED_TICK_PROFILING\s+)SCHED_DISABLE\b", r"\1SCHED_ENABLE", text)
+    if not found:
+        sys.exit("SCHED_TICK_PROFILING not found in %s" % SCHED_CFG)
+    return text
+
+
+def generate(size):
+    """Writes the configuration of size runnables , returns its include directory & source"""
+    cfg_dir = os.path.join(OUT_DIR, str(size))
+    names = ["Bench%d" % idx for idx in range(size)]
+    runnables = []
+    for idx, name in enumerate(names):
+        period = PERIODS_MS[idx % len(PERIODS_MS)]
+        # Spread the first releases so the runnables of the same period don't share their ticks
+        runnables.append("\t[%s] = {.Name = \"%s\" , .PeriodicityMs = %d , .DelayTimeMs = %d , .cb = SCHED_SIM_RUNNABLE(%s)}"
+                         % (name, name, period, (idx * 7) % period, name))
+
+    write(os.path.join(cfg_dir, "CFG", "RunnablesList_Cfg.h"), ENUM_H % "".join("\t%s,\n" % name for name in names))
+    write(os.path.join(cfg_dir, "CFG", "Sched_Cfg.h"), bench_sched_cfg())
+    source = os.path.join(cfg_dir, "RunnablesList_Cfg.c")
+    write(source, LIST_C % ("\n".join("SCHED_SIM_DEFINE_RUNNABLE(%s)" % name for name in names),
+                            " ,\n".join(runnables),
+                            " ,\n".join("\t[%s] = {.MinCycles = %d , .MaxCycles = %d}" % ((name,) + COST_CYCLES) for name in names)))
+    return cfg_dir, source
+
+
+def simulate(command, env, size):
+    """Runs one simulation , returns the simulated ticks , the tick time in ms & the average cycles of a tick"""
+    result = subprocess.run(command, env=env, stdout=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("Simulation of %d runnables failed" % size)
+
+    ticks = re.search(r"= (\d+) ticks of (\d+) (ms|us) in", result.stdout)
+    cost = re.search(r"Tick cost : \d+ ticks , Average (\d+) cycles", result.stdout)
+    if not (ticks and cost):
+        sys.exit("Unexpected output of the simulator :\n%s" % result.stdout)
+    tick_ms = int(ticks.group(2)) / (1000.0 if ticks.group(3) == "us" else 1.0)
+    return int(ticks.group(1)), tick_ms, int(cost.group(1))
+
+
+def run(size, hours, runs):
+    """Simulates size runnables , returns the lowest average host cycles of a tick & the releases per tick"""
+    cfg_dir, source = generate(size)
+    sim = os.path.join(cfg_dir, "Sched_Sim")
+    env = dict(os.environ, SCHED_SIM_CFG_INC=cfg_dir, SCHED_SIM_CFG_SRC=source, SCHED_SIM_OUT=sim,
+               CFLAGS="-O2 -DDWT_SIM_HOST_CYCLES")
+
+    # The first run builds the simulator , the others reuse it
+    ticks, tick_ms, avg = simulate(["sh", os.path.join(ROOT, "tools", "Sched_Sim.sh"), str(hours)], env, size)
+    for _ in range(runs - 1):
+        avg = min(avg, simulate([sim, str(hours)], env, size)[2])
+    releases = sum(ticks * tick_ms / PERIODS_MS[idx % len(PERIODS_MS)] for idx in range(size))
+    return avg, releases / ticks
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Scheduler tick cost benchmark")
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1, 8, 16, 32, 64, 128], help="numbers of runnables")
+    parser.add_argument("--hours", type=int, default=1, help="simulated hours per run")
+    parser.add_argument("--runs", type=int, default=3, help="runs per size , the lowest average is kept")
+    args = parser.parse_args()
+
+    print("%12s %20s %18s" % ("_MaxRunnables", "Host cycles / tick", "Releases / tick"))
+    for size in args.sizes:
+        avg, releases = run(size, args.hours, max(args.runs, 1))
+        print("%12d %20d %18.3f" % (size, avg, releases))
+
+
+if __name__ == "__main__":
+    main()
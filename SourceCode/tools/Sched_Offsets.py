@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+ ============================================================================
+ Name        : Sched_Offsets.py
+ Author      : Farah Mohey
+ Description : Offline release-offset optimizer for the Scheduler runnables
+ Created	 : 26-Apr-24
+ ============================================================================
+
+ Reads RunnableList from src/CFG/RunnablesList_Cfg.c , computes the hyperperiod
+ (LCM of the periods in ticks) & assigns to every runnable the first release
+ which minimizes the worst-case load of any single tick over the hyperperiod.
+
+ The offsets are written to src/CFG/RunnablesOffsets_Cfg.c (RunnableOffsetsUs)
+ which replaces DelayTimeMs + DelayTimeUs when SCHED_OPTIMIZED_OFFSETS is enabled
+ in Sched_Cfg.h. A runnable is never released before its configured delay.
+ The tick is TICK_TIME_US of include/CFG/Sched_Tick_Cfg.h (tools/Sched_Tick.py).
+
+ Usage : python3 tools/Sched_Offsets.py [--cost costs.txt] [--dry-run]
+         costs.txt --> one "RunnableName cost" per line (e.g. measured cycles of
+         Sched_GetRunnableStats) , runnables not listed cost 1 (count of releases).
+"""
+
+import argparse
+import math
+import os
+import sys
+
+from Cfg_Parse import ROOT, has_callback, read_define, read_enum, read_runnables, read_table
+
+CFG_FILE = os.path.join(ROOT, "src", "CFG", "RunnablesList_Cfg.c")
+ENUM_FILE = os.path.join(ROOT, "include", "CFG", "RunnablesList_Cfg.h")
+TICK_H = os.path.join(ROOT, "include", "CFG", "Sched_Tick_Cfg.h")
+OUT_FILE = os.path.join(ROOT, "src", "CFG", "RunnablesOffsets_Cfg.c")
+
+# Hyperperiods longer than this are rejected (memory of the load table)
+MAX_HYPERPERIOD_TICKS = 10000000
+
+
+def us_to_ticks(time_us, tick_us):
+    # Same rounding of Sched_TimeToTicks
+    return (time_us + tick_us - 1) // tick_us
+
+
+def read_costs(path):
+    costs = {}
+    if path:
+        for line in open(path):
+            parts = line.split()
+            if len(parts) == 2:
+                costs[parts[0]] = int(parts[1])
+    return costs
+
+
+def add_load(load, offset, period, cost):
+    hyper = len(load)
+    if period:
+        for tick in range(offset % period, hyper, period):
+            load[tick] += cost
+    elif offset < hyper:
+        load[offset] += cost
+
+
+def report(title, load):
+    peak = max(load) if load else 0
+    avg = (sum(load) / len(load)) if load else 0
+    busy = sum(1 for value in load if value)
+    print("%-10s peak load/tick = %-8d average load/tick = %-10.3f busy ticks = %d / %d"
+          % (title, peak, avg, busy, len(load)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Scheduler release-offset optimizer")
+    parser.add_argument("--cost", help="file of 'RunnableName cost' lines")
+    parser.add_argument("--dry-run", action="store_true", help="print the report without writing the offsets")
+    args = parser.parse_args()
+
+    tick_us = read_define(TICK_H, "TICK_TIME_US")
+    order = read_enum(ENUM_FILE, "_MaxRunnables")
+    # Only RunnableList , the offsets are not used with the tables of the modes (SCHED_MODES)
+    runnables = read_runnables(read_table(CFG_FILE, "RunnableList"))
+    costs = read_costs(args.cost)
+
+    tasks = []
+    for idx in order:
+        if idx in runnables and has_callback(runnables[idx]):
+            task = dict(runnables[idx])
+            task["idx"] = idx
+            task["period"] = us_to_ticks(task["period_us"], tick_us)
+            task["delay"] = us_to_ticks(task["delay_us"], tick_us)
+            task["cost"] = costs.get(task["name"], 1)
+            tasks.append(task)
+
+    periods = [task["period"] for task in tasks if task["period"]]
+    hyper = 1
+    for period in periods:
+        hyper = hyper * period // math.gcd(hyper, period)
+    if hyper > MAX_HYPERPERIOD_TICKS:
+        sys.exit("Hyperperiod of %d ticks is too long , review the periods" % hyper)
+
+    # The delays shift the pattern , cover them by extending the window by the longest delay
+    window = hyper + max([task["delay"] for task in tasks] + [0])
+
+    before = [0] * window
+    for task in tasks:
+        add_load(before, task["delay"], task["period"], task["cost"])
+
+    # Greedy : the heaviest & most frequent runnables are placed first when the table is still empty
+    offsets = {}
+    after = [0] * window
+    for task in sorted(tasks, key=lambda t: (-t["cost"] * (hyper // t["period"] if t["period"] else 1), t["period"])):
+        best = task["delay"]
+        if task["period"]:
+            best_key = None
+            for offset in range(task["delay"], task["delay"] + task["period"]):
+                ticks = range(offset, window, task["period"])
+                key = (max(after[t] for t in ticks), sum(after[t] for t in ticks))
+                if best_key is None or key < best_key:
+                    best, best_key = offset, key
+        add_load(after, best, task["period"], task["cost"])
+        offsets[task["idx"]] = best
+
+    print("Tick = %d us , Hyperperiod = %d ticks (%d us)" % (tick_us, hyper, hyper * tick_us))
+    report("Configured", before)
+    report("Optimized", after)
+    print()
+    print("%-20s %12s %14s %14s" % ("Runnable", "Period(us)", "Delay(us)", "Optimized(us)"))
+    for task in tasks:
+        print("%-20s %12d %14d %14d" % (task["idx"], task["period_us"], task["delay_us"], offsets[task["idx"]] * tick_us))
+
+    if not args.dry_run:
+        write_offsets(order, offsets, tick_us)
+        print("\nWritten %s" % os.path.relpath(OUT_FILE, ROOT))
+
+
+def write_offsets(order, offsets, tick_us):
+    lines = []
+    for idx in order:
+        if idx in offsets:
+            lines.append("\t[%s] = %d," % (idx, offsets[idx] * tick_us))
+    with open(OUT_FILE, "w") as out:
+        out.write(HEADER)
+        out.write("\n".join(lines))
+        out.write("\n};\n")
+
+
+HEADER = """/*
+ ============================================================================
+ Name        : RunnablesOffsets_Cfg.c
+ Author      : Farah Mohey
+ Description : Source File of the optimized first release of the Scheduler runnables
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+/* Generated by tools/Sched_Offsets.py , don't edit it manually */
+
+/******************************* Includes **************************************/
+
+#include "CFG/RunnablesList_Cfg.h"
+#include "Service/Scheduler.h"
+
+/***************************** Implementation **********************************/
+
+/*First release of every runnable in microseconds , used instead of DelayTimeMs + DelayTimeUs when SCHED_OPTIMIZED_OFFSETS is enabled */
+const u32 RunnableOffsetsUs[_MaxRunnables] =
+{
+"""
+
+
+if __name__ == "__main__":
+    main()
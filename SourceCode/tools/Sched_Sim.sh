@@ -0,0 +1,50 @@
+#!/bin/sh
+# ============================================================================
+# Name        : Sched_Sim.sh
+# Author      : Farah Mohey
+# Description : Builds & runs the host virtual time simulator of the Scheduler
+# Created	  : 26-Apr-24
+# ============================================================================
+#
+# Compiles the real src/Service/Scheduler.c & src/Service/SwTimer.c for the host with the simulated
+# core , SysTick , NVIC , RCC , DWT & IWDG of src/SIM (CORE_SIM) & runs it.
+#
+# Usage : sh tools/Sched_Sim.sh [Hours]           (Default 24 simulated hours)
+#
+# Environment :
+#   SCHED_SIM_CFG_INC     Directory holding CFG/RunnablesList_Cfg.h & CFG/Sched_Tick_Cfg.h
+#                         (Generated by tools/Sched_Tick.py --cfg ... --out ...) & optionally
+#                         CFG/Sched_Cfg.h of the simulated runnables (include/SIM)
+#   SCHED_SIM_CFG_SRC     Source defining RunnableList & SchedSimCostList
+#                         (src/SIM/CFG/RunnablesList_Cfg.c)
+#   SCHED_SIM_OFFSETS_SRC Source defining RunnableOffsetsUs , needed when
+#                         SCHED_OPTIMIZED_OFFSETS is enabled
+#   SCHED_SIM_OUT         Output executable (build/Sched_Sim)
+#   SCHED_SIM_WRAP        1 --> The tick counter & CYCCNT start just below 2^32 ,
+#                         the report must be the same as the one of a normal run
+#   CC , CFLAGS           Host compiler & flags (cc , -O2)
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+CFG_INC=${SCHED_SIM_CFG_INC:-$ROOT/include/SIM}
+CFG_SRC=${SCHED_SIM_CFG_SRC:-$ROOT/src/SIM/CFG/RunnablesList_Cfg.c}
+OUT=${SCHED_SIM_OUT:-$ROOT/build/Sched_Sim}
+
+# Wrap around of the tick counter after 1024 ticks & of CYCCNT after 2^24 cycles
+WRAP_FLAGS=
+if [ "${SCHED_SIM_WRAP:-0}" = 1 ]; then
+	WRAP_FLAGS="-DSCHED_START_TICK=0xFFFFFC00UL -DDWT_SIM_START_CYCLES=0xFF000000UL"
+fi
+
+mkdir -p "$(dirname "$OUT")"
+
+${CC:-cc} ${CFLAGS:--O2} $WRAP_FLAGS -std=gnu11 -DCORE_SIM -I"$CFG_INC" -I"$ROOT/include" \
+	"$ROOT/src/Service/Scheduler.c" "$ROOT/src/Service/SwTimer.c" \
+	"$ROOT/src/SIM/Core_Sim.c" "$ROOT/src/SIM/STK_Sim.c" "$ROOT/src/SIM/NVIC_Sim.c" "$ROOT/src/SIM/RCC_Sim.c" \
+	"$ROOT/src/SIM/DWT_Sim.c" "$ROOT/src/SIM/IWDG_Sim.c" "$ROOT/src/SIM/Sched_Sim.c" \
+	"$CFG_SRC" ${SCHED_SIM_OFFSETS_SRC:+"$SCHED_SIM_OFFSETS_SRC"} \
+	-o "$OUT"
+
+"$OUT" "$@"
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+ ============================================================================
+ Name        : Sched_Tick.py
+ Author      : Farah Mohey
+ Description : Build time generator of the tick time of the Scheduler
+ Created	 : 26-Apr-24
+ ============================================================================
+
+ Reads RunnableList (& the tables of the other modes when SCHED_MODES is used)
+ from src/CFG/RunnablesList_Cfg.c & writes the GCD of the periods & delays
+ (PeriodicityMs + PeriodicityUs , DelayTimeMs + DelayTimeUs) of the periodic
+ runnables of all the tables as TICK_TIME_US in include/CFG/Sched_Tick_Cfg.h .
+ The tick is the coarsest one releasing every runnable exactly on time ,
+ so the SysTick interrupts only as often as the fastest runnables need.
+
+ The tick is limited by the 24 bit RELOAD of the SysTick at the highest HCLK
+ (CLK_MAX_FREQUENCY_HZ of include/CFG/STK_Cfg.h , largest divisor of the GCD
+ fitting in it) & rejected below --min-us (e.g. periods of 1000 us
+ & 1001 us need a tick of 1 us). Without periodic runnables the tick is
+ DEFAULT_TICK_US. Runnables registered at runtime (Sched_RegisterRunnable)
+ are not in RunnableList , add their periods by --extra-us or they are
+ rounded up to a multiple of the tick.
+
+ Usage : python3 tools/Sched_Tick.py [--extra-us 250 ...] [--min-us 50] [--dry-run]
+         python3 tools/Sched_Tick.py --cfg src/SIM/CFG/RunnablesList_Cfg.c \\
+                 --enum include/SIM/CFG/RunnablesList_Cfg.h --out include/SIM/CFG/Sched_Tick_Cfg.h
+"""
+
+import argparse
+import functools
+import math
+import os
+import re
+import sys
+
+from Cfg_Parse import ROOT, has_callback, read_define, read_entries, read_enum, read_runnables, read_source
+
+CFG_FILE = os.path.join(ROOT, "src", "CFG", "RunnablesList_Cfg.c")
+ENUM_FILE = os.path.join(ROOT, "include", "CFG", "RunnablesList_Cfg.h")
+STK_CFG_H = os.path.join(ROOT, "include", "CFG", "STK_Cfg.h")
+OUT_FILE = os.path.join(ROOT, "include", "CFG", "Sched_Tick_Cfg.h")
+
+# Tick of a configuration without periodic runnables
+DEFAULT_TICK_US = 2000
+
+# Counts of the SysTick period (RELOAD + 1) , Sched_Init uses the processor clock
+STK_MAX_COUNTS = 0x01000000
+
+US_PER_SEC = 1000000
+
+
+def read_tables(path):
+    # Only the initializers of the Runnable_t tables : RunnableList & the tables of the modes
+    # (The simulated configuration defines SchedSimCostList too , SchedModeList holds pointers only)
+    bodies = re.findall(r"Runnable_t\s+\w+\s*\[[^\]]*\]\s*=\s*\{(.*?)\n\s*\}\s*;", read_source(path), flags=re.S)
+    return [read_runnables(read_entries(body)) for body in bodies]
+
+
+def max_tick_us(clock_hz):
+    return STK_MAX_COUNTS * US_PER_SEC // clock_hz
+
+
+def fit_tick(gcd_us, limit_us):
+    # Largest divisor of the GCD fitting in the SysTick , every period stays a multiple of it
+    for tick in range(min(gcd_us, limit_us), 0, -1):
+        if gcd_us % tick == 0:
+            return tick
+    return 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Scheduler tick generator")
+    parser.add_argument("--cfg", default=CFG_FILE, help="source defining RunnableList & the tables of the modes")
+    parser.add_argument("--enum", default=ENUM_FILE, help="header of the enum of the runnables")
+    parser.add_argument("--out", default=OUT_FILE, help="generated header")
+    parser.add_argument("--extra-us", type=int, nargs="*", default=[], help="periods of the runnables registered at runtime")
+    parser.add_argument("--min-us", type=int, default=50, help="finest accepted tick")
+    parser.add_argument("--dry-run", action="store_true", help="print the tick without writing the header")
+    args = parser.parse_args()
+
+    # The expected HCLK & the highest one the application switches to
+    clock_hz = read_define(STK_CFG_H, "CLK_FREQUENCY_MHZ")
+    max_clock_hz = read_define(STK_CFG_H, "CLK_MAX_FREQUENCY_HZ")
+    order = read_enum(args.enum, "_MaxRunnables")
+    tables = read_tables(args.cfg)
+
+    times = list(args.extra_us)
+    for runnables in tables:
+        for idx in order:
+            task = runnables.get(idx)
+            if task and has_callback(task) and not task["event"]:
+                times += [task["period_us"], task["delay_us"]]
+    times = [time for time in times if time]
+
+    if times:
+        tick_us = fit_tick(functools.reduce(math.gcd, times), max_tick_us(max_clock_hz))
+    else:
+        tick_us = DEFAULT_TICK_US
+
+    if tick_us < args.min_us:
+        sys.exit("Tick of %d us is finer than %d us , review the periods %s" % (tick_us, args.min_us, sorted(set(times))))
+    for hz in (clock_hz, max_clock_hz):
+        if (hz * tick_us) % US_PER_SEC:
+            sys.exit("Tick of %d us is not a whole number of cycles of the %d Hz clock" % (tick_us, hz))
+
+    print("Tick = %d us (%d cycles , %d at the highest HCLK) , %d interrupts/s"
+          % (tick_us, clock_hz * tick_us // US_PER_SEC, max_clock_hz * tick_us // US_PER_SEC, US_PER_SEC // tick_us))
+
+    if not args.dry_run:
+        with open(args.out, "w") as out:
+            out.write(HEADER % tick_us)
+        print("Written %s" % os.path.relpath(args.out, ROOT))
+
+
+HEADER = """/*
+ ============================================================================
+ Name        : Sched_Tick_Cfg.h
+ Author      : Farah Mohey
+ Description : Header file of the tick time of the Scheduler
+ Created	 : 26-Apr-24
+ ============================================================================
+ */
+
+#ifndef CFG_SCHED_TICK_CFG_H_
+#define CFG_SCHED_TICK_CFG_H_
+
+/* Generated by tools/Sched_Tick.py , don't edit it manually */
+
+/*******************************  Definitions  *********************************/
+
+/* Scheduler tick in microseconds : GCD of the periods & delays of RunnableList & the tables of the modes */
+#define TICK_TIME_US			%d
+
+
+
+#endif /* CFG_SCHED_TICK_CFG_H_ */
+"""
+
+
+if __name__ == "__main__":
+    main()